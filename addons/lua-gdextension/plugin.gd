@@ -23,11 +23,16 @@ extends EditorPlugin
 
 
 var _lua_repl: Control
+var _export_plugin: EditorExportPlugin
 
 
 func _enter_tree():
 	_lua_repl = preload("lua_repl.tscn").instantiate()
 	add_control_to_bottom_panel(_lua_repl, "Lua REPL")
+	_export_plugin = LuaScriptExportPlugin.new()
+	add_export_plugin(_export_plugin)
+	EditorInterface.get_resource_filesystem().filesystem_changed.connect(_on_filesystem_changed)
+	EditorInterface.get_resource_filesystem().script_classes_updated.connect(_on_script_classes_updated)
 
 
 func _exit_tree():
@@ -35,3 +40,28 @@ func _exit_tree():
 		remove_control_from_bottom_panel(_lua_repl)
 		_lua_repl.queue_free()
 		_lua_repl = null
+	if _export_plugin:
+		remove_export_plugin(_export_plugin)
+		_export_plugin = null
+	EditorInterface.get_resource_filesystem().filesystem_changed.disconnect(_on_filesystem_changed)
+	EditorInterface.get_resource_filesystem().script_classes_updated.disconnect(_on_script_classes_updated)
+
+
+func _on_filesystem_changed():
+	# Lua files may have been added or removed, so `require` must search for them again
+	LuaState.clear_module_resolution_cache()
+	# Persist script analysis results computed during the scan
+	_get_lua_script_language().save_script_analysis_cache()
+
+
+func _on_script_classes_updated():
+	# Global classes may have been added, so Lua states must look for them again
+	LuaState.clear_global_class_cache()
+
+
+func _get_lua_script_language() -> LuaScriptLanguage:
+	for i in Engine.get_script_language_count():
+		var language = Engine.get_script_language(i)
+		if language is LuaScriptLanguage:
+			return language
+	return null
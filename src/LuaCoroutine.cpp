@@ -25,7 +25,9 @@
 #include "LuaFunction.hpp"
 #include "utils/LuaCoroutinePool.hpp"
 #include "utils/VariantArguments.hpp"
+#include "utils/boundary_counters.hpp"
 #include "utils/convert_godot_lua.hpp"
+#include "utils/performance_counters.hpp"
 #include "utils/string_names.hpp"
 
 #include <godot_cpp/variant/utility_functions.hpp>
@@ -86,6 +88,8 @@ Variant LuaCoroutine::invoke_lua(Ref<LuaFunction> f, const VariantArguments& arg
 }
 
 Variant LuaCoroutine::invoke_lua(const sol::protected_function& f, const VariantArguments& args, bool return_lua_error) {
+	count_godot_to_lua_call();
+	count_lua_invoke(BOUNDARY_LUA_COROUTINE_INVOKE, f);
 	LuaCoroutinePool pool(f.lua_state());
 	sol::thread coroutine = pool.acquire(f);
 	sol::protected_function_result result = _resume(coroutine.thread_state(), args);
@@ -98,6 +102,69 @@ Variant LuaCoroutine::invoke_lua(const sol::protected_function& f, const Variant
 	}
 }
 
+#ifndef LUAJIT
+struct LuaBatchInvocation {
+	const Array& selves;
+	const Variant **argv;
+	int argc;
+	int64_t next_index;
+};
+
+static int batch_invocation_continuation(lua_State *L, int status, lua_KContext ctx) {
+	// Resumed after a call yielded: the remaining objects were handled by another coroutine
+	return 0;
+}
+
+static int batch_invocation_loop(lua_State *L) {
+	LuaBatchInvocation *batch = (LuaBatchInvocation *) lua_touserdata(L, lua_upvalueindex(1));
+	// The called function is the coroutine's first argument
+	while (batch->next_index < batch->selves.size()) {
+		const Variant& self = batch->selves[batch->next_index++];
+		lua_pushvalue(L, 1);
+		int nargs = sol::stack::push(L, VariantArguments(self, batch->argv, batch->argc));
+		lua_callk(L, nargs, 0, 0, batch_invocation_continuation);
+	}
+	return 0;
+}
+#endif
+
+void LuaCoroutine::invoke_lua_batch(const sol::protected_function& f, const Array& selves, const Array& args) {
+	VariantArguments arguments(args);
+	const Variant **argv = arguments.argv();
+	int argc = arguments.argc();
+#ifdef LUAJIT
+	// LuaJIT cannot yield across C calls, so each object gets its own coroutine
+	for (int64_t i = 0; i < selves.size(); i++) {
+		invoke_lua(f, VariantArguments(selves[i], argv, argc), false);
+	}
+#else
+	lua_State *L = f.lua_state();
+	LuaBatchInvocation batch { selves, argv, argc, 0 };
+	lua_pushlightuserdata(L, &batch);
+	lua_pushcclosure(L, batch_invocation_loop, 1);
+	sol::function loop(L, -1);
+	lua_pop(L, 1);
+
+	LuaCoroutinePool pool(L);
+	while (batch.next_index < selves.size()) {
+		count_godot_to_lua_call();
+		count_lua_invoke(BOUNDARY_LUA_COROUTINE_INVOKE, f);
+		sol::thread coroutine = pool.acquire(loop);
+		lua_State *thread_state = coroutine.thread_state();
+		f.push(thread_state);
+		int nresults;
+		int status = resume_lua_coroutine(thread_state, 1, &nresults);
+		if (status == LUA_YIELD) {
+			// The yielded call keeps this coroutine, it will finish when resumed
+			continue;
+		}
+		sol::protected_function_result result(thread_state, -nresults, nresults, nresults, static_cast<sol::call_status>(status));
+		to_variant(result, false);
+		pool.release(coroutine);
+	}
+#endif
+}
+
 void LuaCoroutine::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("resumev", "arguments"), &LuaCoroutine::resumev);
 	ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "resume", &LuaCoroutine::resume);
@@ -48,6 +48,9 @@ public:
 
 	static Variant invoke_lua(Ref<LuaFunction> f, const VariantArguments& args, bool return_lua_error);
 	static Variant invoke_lua(const sol::protected_function& f, const VariantArguments& args, bool return_lua_error);
+	// Calls `f(self, ...args)` for each object in `selves`, ignoring the results.
+	// Calls are made in a loop inside a single coroutine, only moving to a new one when a call yields or fails.
+	static void invoke_lua_batch(const sol::protected_function& f, const Array& selves, const Array& args);
 
 protected:
 	static void _bind_methods();
@@ -23,7 +23,9 @@
 
 #include "LuaDebug.hpp"
 #include "utils/VariantArguments.hpp"
+#include "utils/boundary_counters.hpp"
 #include "utils/convert_godot_lua.hpp"
+#include "utils/performance_counters.hpp"
 #include "utils/string_names.hpp"
 
 #include <godot_cpp/core/error_macros.hpp>
@@ -39,6 +41,7 @@ void LuaFunction::_bind_methods() {
 	ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "invoke", &LuaFunction::invoke);
 	ClassDB::bind_method(D_METHOD("to_callable"), &LuaFunction::to_callable);
 	ClassDB::bind_method(D_METHOD("get_debug_info"), &LuaFunction::get_debug_info);
+	ClassDB::bind_method(D_METHOD("dump", "strip"), static_cast<PackedByteArray (LuaFunction::*)(bool) const>(&LuaFunction::dump), DEFVAL(false));
 }
 
 Variant LuaFunction::invokev(const Array& args) {
@@ -55,6 +58,8 @@ Variant LuaFunction::invoke_lua(Ref<LuaFunction> f, const VariantArguments& args
 }
 
 Variant LuaFunction::invoke_lua(const sol::protected_function& f, const VariantArguments& args, bool return_lua_error) {
+	count_godot_to_lua_call();
+	count_lua_invoke(BOUNDARY_LUA_FUNCTION_INVOKE, f);
 	sol::protected_function_result result = f.call(args);
 	return to_variant(result, return_lua_error);
 }
@@ -69,6 +74,32 @@ Ref<LuaDebug> LuaFunction::get_debug_info() const {
 	return memnew(LuaDebug(std::move(debug)));
 }
 
+PackedByteArray LuaFunction::dump(bool strip) const {
+	return dump(lua_object, strip);
+}
+
+static int bytecode_writer(lua_State *L, const void *p, size_t size, PackedByteArray *bytecode) {
+	int64_t offset = bytecode->size();
+	bytecode->resize(offset + size);
+	memcpy(bytecode->ptrw() + offset, p, size);
+	return 0;
+}
+
+PackedByteArray LuaFunction::dump(const sol::protected_function& f, bool strip) {
+	PackedByteArray bytecode;
+	lua_State *L = f.lua_state();
+	f.push(L);
+#if LUA_VERSION_NUM >= 503
+	int status = lua_dump(L, (lua_Writer) bytecode_writer, &bytecode, strip);
+#else
+	// LuaJIT's lua_dump does not support stripping debug information
+	int status = lua_dump(L, (lua_Writer) bytecode_writer, &bytecode);
+#endif
+	lua_pop(L, 1);
+	ERR_FAIL_COND_V_MSG(status != 0, PackedByteArray(), "Cannot dump Lua function, only Lua functions without native code can be dumped");
+	return bytecode;
+}
+
 const sol::protected_function& LuaFunction::get_function() const {
 	return lua_object;
 }
@@ -47,6 +47,9 @@ public:
 
 	Callable to_callable() const;
 	Ref<LuaDebug> get_debug_info() const;
+	PackedByteArray dump(bool strip = false) const;
+
+	static PackedByteArray dump(const sol::protected_function& f, bool strip);
 
 	const sol::protected_function& get_function() const;
 
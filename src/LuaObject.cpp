@@ -45,6 +45,10 @@ String LuaObject::_to_string() const {
 	return String("[%s:0x%x]") % Array::make(get_class(), get_pointer_value());
 }
 
+int64_t LuaObject::get_known_object_count() {
+	return known_objects.size();
+}
+
 HashMap<const void *, LuaObject *> LuaObject::known_objects;
 
 }
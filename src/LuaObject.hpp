@@ -40,6 +40,8 @@ public:
 
 	uint64_t get_pointer_value() const;
 
+	static int64_t get_known_object_count();
+
 	template<typename Subclass, typename ref_t>
 	static Ref<Subclass> wrap_object(const sol::basic_object<ref_t>& lua_obj) {
 		if (LuaObject **known_obj = known_objects.getptr(lua_obj.pointer())) {
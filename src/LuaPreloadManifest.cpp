@@ -0,0 +1,285 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaPreloadManifest.hpp"
+
+#include "LuaAST.hpp"
+#include "LuaASTNode.hpp"
+#include "LuaASTQuery.hpp"
+#include "LuaParser.hpp"
+#include "script-language/LuaScriptBytecodeArchive.hpp"
+#include "script-language/LuaScriptBytecodeCache.hpp"
+#include "utils/module_resolution_cache.hpp"
+#include "utils/project_settings.hpp"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/resource_uid.hpp>
+
+namespace luagdextension {
+
+HashMap<String, LuaPreloadManifest::PreloadedBytecode> LuaPreloadManifest::preloaded_bytecode;
+Mutex LuaPreloadManifest::preloaded_bytecode_mutex;
+
+LuaPreloadManifest::LuaPreloadManifest() {}
+
+LuaPreloadManifest::~LuaPreloadManifest() {
+	clear_preloaded();
+}
+
+PackedStringArray LuaPreloadManifest::get_modules() const {
+	return modules;
+}
+
+void LuaPreloadManifest::set_modules(const PackedStringArray& modules) {
+	clear_preloaded();
+	this->modules = modules;
+}
+
+void LuaPreloadManifest::start_preload() {
+	if (preload_task >= 0 || is_preloaded || modules.is_empty()) {
+		return;
+	}
+	module_preloaded.resize(modules.size());
+	module_preloaded.fill(0);
+	preload_task = WorkerThreadPool::get_singleton()->add_group_task(callable_mp(this, &LuaPreloadManifest::_preload_module), modules.size(), -1, true, "Preload Lua modules");
+}
+
+bool LuaPreloadManifest::is_preload_done() const {
+	return preload_task >= 0
+		? WorkerThreadPool::get_singleton()->is_group_task_completed(preload_task)
+		: is_preloaded;
+}
+
+void LuaPreloadManifest::wait_preload() {
+	if (preload_task < 0) {
+		return;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(preload_task);
+	preload_task = -1;
+	is_preloaded = true;
+}
+
+void LuaPreloadManifest::clear_preloaded() {
+	wait_preload();
+	if (!is_preloaded) {
+		return;
+	}
+
+	MutexLock lock(preloaded_bytecode_mutex);
+	for (int i = 0; i < module_preloaded.size(); i++) {
+		if (!module_preloaded[i]) {
+			continue;
+		}
+		if (PreloadedBytecode *entry = preloaded_bytecode.getptr(modules[i]); entry && --entry->manifest_count <= 0) {
+			preloaded_bytecode.erase(modules[i]);
+		}
+	}
+	module_preloaded.clear();
+	is_preloaded = false;
+}
+
+void LuaPreloadManifest::_preload_module(uint32_t index) {
+	const String& path = modules[index];
+	PackedByteArray bytecode;
+	LuaScriptBytecodeArchive *archive = LuaScriptBytecodeArchive::get_singleton();
+	if (archive && archive->has_file(path)) {
+		bytecode = archive->get_bytecode(path);
+	}
+	else if (FileAccess::file_exists(path)) {
+		String error;
+		bytecode = LuaScriptBytecodeCache::compile(FileAccess::get_file_as_bytes(path), path, false, &error);
+		if (bytecode.is_empty()) {
+			WARN_PRINT(String("Cannot preload Lua module '%s': %s") % Array::make(path, error));
+		}
+	}
+	if (bytecode.is_empty()) {
+		return;
+	}
+
+	MutexLock lock(preloaded_bytecode_mutex);
+	if (PreloadedBytecode *entry = preloaded_bytecode.getptr(path)) {
+		entry->manifest_count++;
+	}
+	else {
+		preloaded_bytecode.insert(path, { bytecode, 1 });
+	}
+	// Each task writes to its own index, so no extra synchronization is needed
+	module_preloaded.ptrw()[index] = 1;
+}
+
+Dictionary LuaPreloadManifest::get_require_graph(const PackedStringArray& paths, const String& package_path) {
+	String path_string = package_path.is_empty()
+		? (String) ProjectSettings::get_singleton()->get_setting_with_override(LUA_PATH_SETTING)
+		: package_path;
+	PackedStringArray path_templates;
+	for (const String& path_template : path_string.split(";", false)) {
+		// Only project files can be analyzed, paths relative to the executable are left out
+		if (path_template.begins_with("res://") || path_template.begins_with("user://")) {
+			path_templates.append(path_template);
+		}
+	}
+
+	Dictionary graph;
+	PackedStringArray pending = paths;
+	while (!pending.is_empty()) {
+		String path = pending[pending.size() - 1];
+		pending.remove_at(pending.size() - 1);
+		if (graph.has(path)) {
+			continue;
+		}
+		PackedStringArray dependencies = _find_required_modules(path, path_templates);
+		graph[path] = dependencies;
+		pending.append_array(dependencies);
+	}
+	return graph;
+}
+
+Ref<LuaPreloadManifest> LuaPreloadManifest::create_for_scene(const String& scene_path, const String& package_path) {
+	HashSet<String> visited;
+	PackedStringArray lua_files;
+	_collect_scene_lua_files(scene_path, visited, lua_files);
+
+	Dictionary graph = get_require_graph(lua_files, package_path);
+	HashSet<String> sorted_visited;
+	PackedStringArray sorted;
+	for (const String& lua_file : lua_files) {
+		// Scripts themselves are loaded with the scene, only their dependencies need preloading
+		for (const String& dependency : (PackedStringArray) graph[lua_file]) {
+			_sort_dependencies_first(dependency, graph, sorted_visited, sorted);
+		}
+	}
+
+	Ref<LuaPreloadManifest> manifest;
+	manifest.instantiate();
+	manifest->set_modules(sorted);
+	return manifest;
+}
+
+PackedByteArray LuaPreloadManifest::get_preloaded_bytecode(const String& path) {
+	MutexLock lock(preloaded_bytecode_mutex);
+	if (const PreloadedBytecode *entry = preloaded_bytecode.getptr(path)) {
+		return entry->bytecode;
+	}
+	else {
+		return PackedByteArray();
+	}
+}
+
+PackedStringArray LuaPreloadManifest::_find_required_modules(const String& path, const PackedStringArray& path_templates) {
+	PackedStringArray modules;
+	LuaScriptBytecodeArchive *archive = LuaScriptBytecodeArchive::get_singleton();
+	if (archive && archive->has_file(path)) {
+		// Precompiled files have no source to analyze
+		return modules;
+	}
+	if (!FileAccess::file_exists(path)) {
+		return modules;
+	}
+
+	Ref<LuaParser> parser;
+	parser.instantiate();
+	Ref<LuaAST> ast = parser->parse_code(FileAccess::get_file_as_string(path));
+	if (ast.is_null()) {
+		WARN_PRINT(String("Cannot analyze Lua module '%s', its dependencies will be loaded on demand") % path);
+		return modules;
+	}
+	Ref<LuaASTQuery> query = ast->get_root()->query("(function_call name: (identifier) @name arguments: (arguments . (string) @module))");
+	ERR_FAIL_COND_V(!query->is_valid(), modules);
+	TypedArray<Array> matches = query->all_matches();
+	for (int i = 0; i < matches.size(); i++) {
+		Array captures = matches[i];
+		Ref<LuaASTNode> name = captures[0];
+		Ref<LuaASTNode> content = ((Ref<LuaASTNode>) captures[1])->get_child_by_field_name("content");
+		if (name->get_source_code() != "require" || content.is_null()) {
+			continue;
+		}
+		String module_name = content->get_source_code();
+		if (module_name.contains("\\")) {
+			// Escape sequences are not processed, so leave modules with them to be loaded on demand
+			continue;
+		}
+
+		String module_path = module_name.replace(".", "/");
+		for (const String& path_template : path_templates) {
+			String filename = path_template.replace("?", module_path);
+			if (module_file_exists(filename)) {
+				if (!modules.has(filename)) {
+					modules.append(filename);
+				}
+				break;
+			}
+		}
+	}
+	return modules;
+}
+
+void LuaPreloadManifest::_collect_scene_lua_files(const String& path, HashSet<String>& visited, PackedStringArray& lua_files) {
+	if (visited.has(path)) {
+		return;
+	}
+	visited.insert(path);
+
+	for (const String& dependency : ResourceLoader::get_singleton()->get_dependencies(path)) {
+		// Dependencies may be formatted as "<uid>::<type>::<path>"
+		String dependency_path = dependency.get_slice("::", dependency.get_slice_count("::") - 1);
+		if (dependency_path.begins_with("uid://")) {
+			dependency_path = ResourceUID::get_singleton()->get_id_path(ResourceUID::get_singleton()->text_to_id(dependency_path));
+		}
+
+		if (dependency_path.get_extension() == "lua") {
+			if (!lua_files.has(dependency_path)) {
+				lua_files.append(dependency_path);
+			}
+		}
+		else {
+			_collect_scene_lua_files(dependency_path, visited, lua_files);
+		}
+	}
+}
+
+void LuaPreloadManifest::_sort_dependencies_first(const String& path, const Dictionary& graph, HashSet<String>& visited, PackedStringArray& sorted) {
+	if (visited.has(path)) {
+		return;
+	}
+	visited.insert(path);
+	for (const String& dependency : (PackedStringArray) graph.get(path, PackedStringArray())) {
+		_sort_dependencies_first(dependency, graph, visited, sorted);
+	}
+	sorted.append(path);
+}
+
+void LuaPreloadManifest::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_modules"), &LuaPreloadManifest::get_modules);
+	ClassDB::bind_method(D_METHOD("set_modules", "modules"), &LuaPreloadManifest::set_modules);
+	ClassDB::bind_method(D_METHOD("start_preload"), &LuaPreloadManifest::start_preload);
+	ClassDB::bind_method(D_METHOD("is_preload_done"), &LuaPreloadManifest::is_preload_done);
+	ClassDB::bind_method(D_METHOD("wait_preload"), &LuaPreloadManifest::wait_preload);
+	ClassDB::bind_method(D_METHOD("clear_preloaded"), &LuaPreloadManifest::clear_preloaded);
+
+	ClassDB::bind_static_method(LuaPreloadManifest::get_class_static(), D_METHOD("get_require_graph", "paths", "package_path"), &LuaPreloadManifest::get_require_graph, DEFVAL(""));
+	ClassDB::bind_static_method(LuaPreloadManifest::get_class_static(), D_METHOD("create_for_scene", "scene_path", "package_path"), &LuaPreloadManifest::create_for_scene, DEFVAL(""));
+
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "modules"), "set_modules", "get_modules");
+}
+
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_PRELOAD_MANIFEST_HPP__
+#define __LUA_PRELOAD_MANIFEST_HPP__
+
+#include <godot_cpp/classes/resource.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#include <godot_cpp/core/mutex.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * List of Lua modules to be compiled ahead of time, for example during loading screens.
+ *
+ * Manifests are built from the `require` calls with literal module names found in Lua files,
+ * so that modules are compiled in background threads instead of on their first `require`.
+ */
+class LuaPreloadManifest : public Resource {
+	GDCLASS(LuaPreloadManifest, Resource);
+
+public:
+	LuaPreloadManifest();
+	~LuaPreloadManifest();
+
+	PackedStringArray get_modules() const;
+	void set_modules(const PackedStringArray& modules);
+
+	void start_preload();
+	bool is_preload_done() const;
+	void wait_preload();
+	void clear_preloaded();
+
+	static Dictionary get_require_graph(const PackedStringArray& paths, const String& package_path = "");
+	static Ref<LuaPreloadManifest> create_for_scene(const String& scene_path, const String& package_path = "");
+
+	// Used by `loadfile`, `dofile` and `require`, returns an empty array if `path` is not preloaded
+	static PackedByteArray get_preloaded_bytecode(const String& path);
+
+protected:
+	static void _bind_methods();
+
+private:
+	void _preload_module(uint32_t index);
+
+	static PackedStringArray _find_required_modules(const String& path, const PackedStringArray& path_templates);
+	static void _collect_scene_lua_files(const String& path, HashSet<String>& visited, PackedStringArray& lua_files);
+	static void _sort_dependencies_first(const String& path, const Dictionary& graph, HashSet<String>& visited, PackedStringArray& sorted);
+
+	PackedStringArray modules;
+	PackedByteArray module_preloaded;
+	WorkerThreadPool::GroupID preload_task = -1;
+	bool is_preloaded = false;
+
+	struct PreloadedBytecode {
+		PackedByteArray bytecode;
+		int manifest_count;
+	};
+	static HashMap<String, PreloadedBytecode> preloaded_bytecode;
+	static Mutex preloaded_bytecode_mutex;
+};
+
+}
+
+#endif  // __LUA_PRELOAD_MANIFEST_HPP__
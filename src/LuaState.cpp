@@ -26,12 +26,19 @@
 #include "LuaThread.hpp"
 #include "luaopen/godot.hpp"
 #include "utils/_G_metatable.hpp"
+#include "utils/allocation_counters.hpp"
+#include "utils/boundary_counters.hpp"
 #include "utils/convert_godot_lua.hpp"
 #include "utils/module_names.hpp"
+#include "utils/module_resolution_cache.hpp"
+#include "utils/performance_counters.hpp"
+#include "utils/string_names.hpp"
 
 #include <godot_cpp/core/binder_common.hpp>
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/file_access.hpp>
 #include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/performance.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <luaconf.h>
 
@@ -43,24 +50,17 @@
 
 namespace luagdextension {
 
-/// Lua memory allocation callback.
-/// Uses Godot memory functions.
-static void *lua_alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
-	if (nsize == 0) {
-		if (ptr != nullptr) {
-			memfree(ptr);
-		}
-		return nullptr;
-	}
-	else {
-		return memrealloc(ptr, nsize);
-	}
-}
-
 static int lua_panic_handler(lua_State *L) {
 	return sol::default_at_panic(L);
 }
 
+static void lua_memory_soft_limit_handler(void *ud) {
+	// Running the emergency collection right away is not safe, since the allocator
+	// may be running in the middle of a garbage collection step
+	LuaState *L = (LuaState *) ud;
+	callable_mp(L, &LuaState::_on_memory_soft_limit_reached).call_deferred();
+}
+
 #ifdef HAVE_LUA_WARN
 static void lua_warn_handler(void *ud, const char *msg, int tocont) {
 	LuaState *L = (LuaState *) ud;
@@ -68,13 +68,44 @@ static void lua_warn_handler(void *ud, const char *msg, int tocont) {
 }
 #endif
 
+// Indexed by LuaState::PerformanceMonitor
+static const char *PERFORMANCE_MONITOR_NAMES[] = {
+	"Memory used (bytes)",
+	"Memory peak (bytes)",
+	"GC cycles",
+};
+
 LuaState::LuaState()
+	: allocator(std::make_unique<LuaAllocator>(LuaAllocator::MODE_DEFAULT))
 #ifdef LUAJIT  // LuaJIT needs its default allocator in x64 platforms
-	: lua_state(lua_panic_handler)
+	, lua_state(lua_panic_handler)
 #else
-	: lua_state(lua_panic_handler, lua_alloc)
+	, lua_state(lua_panic_handler, &LuaAllocator::alloc, allocator.get())
 #endif
 {
+	setup_lua_state();
+}
+
+LuaState::~LuaState() {
+	remove_performance_monitors();
+	uninstall_gc_cycle_counter(lua_state);
+	valid_states.erase(lua_state);
+#ifdef LUAJIT
+	// LuaJIT only releases its memory arena if the state is closed with the original allocator
+	lua_setallocf(lua_state, luajit_alloc, luajit_alloc_ud);
+#endif
+}
+
+void LuaState::setup_lua_state() {
+#ifdef LUAJIT
+	// Wrap LuaJIT's own allocator, so that allocations are still accounted for
+	luajit_alloc = lua_getallocf(lua_state, &luajit_alloc_ud);
+	allocator = std::make_unique<LuaAllocator>(LuaAllocator::MODE_DEFAULT, luajit_alloc, luajit_alloc_ud);
+	allocator->track_existing_bytes(lua_state.memory_used());
+	lua_setallocf(lua_state, &LuaAllocator::alloc, allocator.get());
+#endif
+	allocator->set_soft_limit_callback(lua_memory_soft_limit_handler, this);
+	install_gc_cycle_counter(lua_state, &gc_cycle_count);
 	setup_G_metatable(lua_state);
 #ifdef HAVE_LUA_WARN
 	lua_setwarnf(lua_state, lua_warn_handler, this);
@@ -82,10 +113,6 @@ LuaState::LuaState()
 	valid_states.insert(lua_state, this);
 }
 
-LuaState::~LuaState() {
-	valid_states.erase(lua_state);
-}
-
 sol::state_view LuaState::get_lua_state() const {
 	return lua_state;
 }
@@ -328,6 +355,181 @@ bool LuaState::supports_gc_mode(GcMode mode) const {
 	return lua_state.supports_gc_mode((sol::gc_mode) mode);
 }
 
+LuaState::Allocator LuaState::get_allocator() const {
+	return (Allocator) allocator->get_mode();
+}
+
+void LuaState::set_allocator(Allocator new_allocator) {
+	if (new_allocator == get_allocator()) {
+		return;
+	}
+#ifdef LUAJIT
+	ERR_FAIL_MSG("Custom allocators are not supported by " + get_lua_runtime() + " runtime, it manages its own memory arena");
+#else
+	ERR_FAIL_COND_MSG(lua_state.registry().get_or("_GDEXTENSION_OPEN_LIBS", 0L) != 0, "Allocator can only be changed before opening libraries");
+
+	// Changing allocators recreates the Lua state, since blocks cannot migrate between them.
+	// The old state is closed by the assignment while the old allocator is still alive.
+	valid_states.erase(lua_state);
+	uninstall_gc_cycle_counter(lua_state);
+	std::unique_ptr<LuaAllocator> old_allocator = std::move(allocator);
+	allocator = std::make_unique<LuaAllocator>((LuaAllocator::Mode) new_allocator);
+	allocator->set_memory_limit(old_allocator->get_memory_limit());
+	allocator->set_memory_soft_limit(old_allocator->get_memory_soft_limit());
+	lua_state = sol::state(lua_panic_handler, &LuaAllocator::alloc, allocator.get());
+	setup_lua_state();
+#endif
+}
+
+Dictionary LuaState::get_allocator_statistics() const {
+	return allocator->get_statistics();
+}
+
+int64_t LuaState::get_memory_limit() const {
+	return allocator->get_memory_limit();
+}
+
+void LuaState::set_memory_limit(int64_t bytes) {
+	ERR_FAIL_COND_MSG(bytes < 0, "Memory limit must not be negative");
+	allocator->set_memory_limit(bytes);
+}
+
+int64_t LuaState::get_memory_soft_limit() const {
+	return allocator->get_memory_soft_limit();
+}
+
+void LuaState::set_memory_soft_limit(int64_t bytes) {
+	ERR_FAIL_COND_MSG(bytes < 0, "Memory soft limit must not be negative");
+	allocator->set_memory_soft_limit(bytes);
+}
+
+uint64_t LuaState::get_memory_peak() const {
+	return allocator->get_peak_bytes_in_use();
+}
+
+void LuaState::reset_memory_peak() {
+	allocator->reset_peak_bytes_in_use();
+}
+
+uint64_t LuaState::get_gc_cycle_count() const {
+	return gc_cycle_count;
+}
+
+void LuaState::start_allocation_profiler(int64_t sample_interval_bytes) {
+#ifdef LUAJIT
+	ERR_FAIL_MSG("Allocation profiler is not supported by " + get_lua_runtime() + " runtime, since its call stack cannot be inspected while allocating memory");
+#else
+	ERR_FAIL_COND_MSG(sample_interval_bytes <= 0, "Sample interval must be positive");
+	allocator->start_profiling(lua_state, sample_interval_bytes);
+#endif
+}
+
+void LuaState::stop_allocation_profiler() {
+	allocator->stop_profiling();
+}
+
+bool LuaState::is_allocation_profiler_running() const {
+	return allocator->is_profiling();
+}
+
+Dictionary LuaState::get_allocation_profile() const {
+	const LuaAllocationProfiler *profiler = allocator->get_profiler();
+	return profiler ? profiler->get_locations() : Dictionary();
+}
+
+Error LuaState::save_allocation_profile(const String& path, bool live_only) const {
+	const LuaAllocationProfiler *profiler = allocator->get_profiler();
+	ERR_FAIL_COND_V_MSG(profiler == nullptr, ERR_UNCONFIGURED, "Allocation profiler was never started");
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), FileAccess::get_open_error(), "Could not open '" + path + "' for writing");
+	file->store_string(profiler->get_folded_stacks(live_only));
+	file->store_string("\n");
+	return OK;
+}
+
+LuaSamplingProfiler *LuaState::get_sampling_profiler() {
+	if (!sampling_profiler) {
+		sampling_profiler = std::make_unique<LuaSamplingProfiler>();
+	}
+	return sampling_profiler.get();
+}
+
+Dictionary LuaState::get_sampling_profile() const {
+	return sampling_profiler ? sampling_profiler->get_stacks() : Dictionary();
+}
+
+Error LuaState::save_sampling_profile(const String& path, ProfileFormat format) const {
+	ERR_FAIL_COND_V_MSG(!sampling_profiler, ERR_UNCONFIGURED, "Sampling profiler was never started");
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), FileAccess::get_open_error(), "Could not open '" + path + "' for writing");
+	switch (format) {
+		case PROFILE_FORMAT_FOLDED:
+			file->store_string(sampling_profiler->get_folded_stacks());
+			break;
+
+		case PROFILE_FORMAT_SPEEDSCOPE:
+			file->store_string(sampling_profiler->get_speedscope_json(path.get_file().get_basename()));
+			break;
+
+		default:
+			ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Invalid profile format");
+	}
+	file->store_string("\n");
+	return OK;
+}
+
+void LuaState::clear_sampling_profile() {
+	if (sampling_profiler) {
+		sampling_profiler->clear();
+	}
+}
+
+void LuaState::add_performance_monitors(const String& category) {
+	ERR_FAIL_COND_MSG(category.is_empty(), "Performance monitor category must not be empty");
+	remove_performance_monitors();
+	Performance *performance = Performance::get_singleton();
+	for (int i = 0; i < MONITOR_MAX; i++) {
+		performance->add_custom_monitor(category + "/" + PERFORMANCE_MONITOR_NAMES[i], callable_mp(this, &LuaState::get_performance_monitor), Array::make(i));
+	}
+	performance_monitor_category = category;
+}
+
+void LuaState::remove_performance_monitors() {
+	if (performance_monitor_category.is_empty()) {
+		return;
+	}
+	Performance *performance = Performance::get_singleton();
+	for (int i = 0; i < MONITOR_MAX; i++) {
+		String id = performance_monitor_category + "/" + PERFORMANCE_MONITOR_NAMES[i];
+		if (performance->has_custom_monitor(id)) {
+			performance->remove_custom_monitor(id);
+		}
+	}
+	performance_monitor_category = String();
+}
+
+uint64_t LuaState::get_performance_monitor(int monitor) const {
+	switch (monitor) {
+		case MONITOR_MEMORY_USED:
+			return get_memory_used();
+		case MONITOR_MEMORY_PEAK:
+			return get_memory_peak();
+		case MONITOR_GC_CYCLES:
+			return gc_cycle_count;
+		default:
+			ERR_FAIL_V_MSG(0, "Invalid performance monitor");
+	}
+}
+
+void LuaState::_on_memory_soft_limit_reached() {
+	allocator->clear_soft_limit_pending();
+	lua_state.collect_garbage();
+	uint64_t memory_used = allocator->get_bytes_in_use();
+	if (allocator->get_memory_soft_limit() > 0 && memory_used > allocator->get_memory_soft_limit()) {
+		emit_signal(string_names->memory_soft_limit_reached, memory_used);
+	}
+}
+
 String LuaState::get_lua_runtime() {
 #ifdef LUAJIT
 	return "luajit";
@@ -370,6 +572,55 @@ String LuaState::get_lua_exec_dir() {
 		: OS::get_singleton()->get_executable_path().get_base_dir();
 }
 
+void LuaState::clear_module_resolution_cache() {
+	clear_module_resolution_caches();
+}
+
+void LuaState::clear_global_class_cache() {
+	luagdextension::clear_global_class_cache();
+}
+
+void LuaState::set_boundary_counters_enabled(bool enabled) {
+	luagdextension::set_boundary_counters_enabled(enabled);
+}
+
+bool LuaState::are_boundary_counters_enabled() {
+	return luagdextension::are_boundary_counters_enabled();
+}
+
+void LuaState::reset_boundary_counters() {
+	luagdextension::reset_boundary_counters();
+}
+
+Array LuaState::get_boundary_counter_report() {
+	return luagdextension::get_boundary_counter_report();
+}
+
+#ifdef DEBUG_ENABLED
+void LuaState::set_allocation_counters_enabled(bool enabled) {
+	luagdextension::set_allocation_counters_enabled(enabled);
+}
+
+bool LuaState::are_allocation_counters_enabled() {
+	return luagdextension::are_allocation_counters_enabled();
+}
+
+void LuaState::reset_allocation_counters() {
+	luagdextension::reset_allocation_counters();
+}
+
+Dictionary LuaState::get_allocation_counters() {
+	return luagdextension::get_allocation_counters();
+}
+
+Dictionary LuaState::count_allocations(const Callable& callable) {
+	ERR_FAIL_COND_V_MSG(!callable.is_valid(), Dictionary(), "Callable is not valid");
+	AllocationCounterScope scope;
+	callable.call();
+	return scope.get_counts();
+}
+#endif
+
 LuaState *LuaState::find_lua_state(lua_State *L) {
 	L = sol::main_thread(L, L);
 	if (LuaState **ptr = valid_states.getptr(L)) {
@@ -414,6 +665,14 @@ void LuaState::_bind_methods() {
 	BIND_ENUM_CONSTANT(GC_MODE_INCREMENTAL);
 	BIND_ENUM_CONSTANT(GC_MODE_GENERATIONAL);
 
+	// Allocator enum
+	BIND_ENUM_CONSTANT(ALLOCATOR_DEFAULT);
+	BIND_ENUM_CONSTANT(ALLOCATOR_POOL);
+
+	// ProfileFormat enum
+	BIND_ENUM_CONSTANT(PROFILE_FORMAT_FOLDED);
+	BIND_ENUM_CONSTANT(PROFILE_FORMAT_SPEEDSCOPE);
+
 	// Methods
 	ClassDB::bind_method(D_METHOD("open_libraries", "libraries"), &LuaState::open_libraries, DEFVAL(BitField<Library>(ALL_LIBS)));
 	ClassDB::bind_method(D_METHOD("are_libraries_opened", "libraries"), &LuaState::are_libraries_opened);
@@ -446,10 +705,46 @@ void LuaState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("change_gc_mode_generational", "minor_multiplier", "major_multiplier"), &LuaState::change_gc_mode_generational);
 	ClassDB::bind_method(D_METHOD("supports_gc_mode", "gc_mode"), &LuaState::supports_gc_mode);
 
+	ClassDB::bind_method(D_METHOD("get_allocator"), &LuaState::get_allocator);
+	ClassDB::bind_method(D_METHOD("set_allocator", "allocator"), &LuaState::set_allocator);
+	ClassDB::bind_method(D_METHOD("get_allocator_statistics"), &LuaState::get_allocator_statistics);
+	ClassDB::bind_method(D_METHOD("get_memory_limit"), &LuaState::get_memory_limit);
+	ClassDB::bind_method(D_METHOD("set_memory_limit", "bytes"), &LuaState::set_memory_limit);
+	ClassDB::bind_method(D_METHOD("get_memory_soft_limit"), &LuaState::get_memory_soft_limit);
+	ClassDB::bind_method(D_METHOD("set_memory_soft_limit", "bytes"), &LuaState::set_memory_soft_limit);
+	ClassDB::bind_method(D_METHOD("get_memory_peak"), &LuaState::get_memory_peak);
+	ClassDB::bind_method(D_METHOD("reset_memory_peak"), &LuaState::reset_memory_peak);
+	ClassDB::bind_method(D_METHOD("get_gc_cycle_count"), &LuaState::get_gc_cycle_count);
+
+	ClassDB::bind_method(D_METHOD("start_allocation_profiler", "sample_interval_bytes"), &LuaState::start_allocation_profiler, DEFVAL(16384));
+	ClassDB::bind_method(D_METHOD("stop_allocation_profiler"), &LuaState::stop_allocation_profiler);
+	ClassDB::bind_method(D_METHOD("is_allocation_profiler_running"), &LuaState::is_allocation_profiler_running);
+	ClassDB::bind_method(D_METHOD("get_allocation_profile"), &LuaState::get_allocation_profile);
+	ClassDB::bind_method(D_METHOD("save_allocation_profile", "path", "live_only"), &LuaState::save_allocation_profile, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_sampling_profile"), &LuaState::get_sampling_profile);
+	ClassDB::bind_method(D_METHOD("save_sampling_profile", "path", "format"), &LuaState::save_sampling_profile, DEFVAL(PROFILE_FORMAT_FOLDED));
+	ClassDB::bind_method(D_METHOD("clear_sampling_profile"), &LuaState::clear_sampling_profile);
+
+	ClassDB::bind_method(D_METHOD("add_performance_monitors", "category"), &LuaState::add_performance_monitors);
+	ClassDB::bind_method(D_METHOD("remove_performance_monitors"), &LuaState::remove_performance_monitors);
+
 	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("get_lua_runtime"), &LuaState::get_lua_runtime);
 	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("get_lua_version_num"), &LuaState::get_lua_version_num);
 	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("get_lua_version_string"), &LuaState::get_lua_version_string);
 	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("get_lua_exec_dir"), &LuaState::get_lua_exec_dir);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("clear_global_class_cache"), &LuaState::clear_global_class_cache);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("clear_module_resolution_cache"), &LuaState::clear_module_resolution_cache);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("set_boundary_counters_enabled", "enabled"), &LuaState::set_boundary_counters_enabled);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("are_boundary_counters_enabled"), &LuaState::are_boundary_counters_enabled);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("reset_boundary_counters"), &LuaState::reset_boundary_counters);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("get_boundary_counter_report"), &LuaState::get_boundary_counter_report);
+#ifdef DEBUG_ENABLED
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("set_allocation_counters_enabled", "enabled"), &LuaState::set_allocation_counters_enabled);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("are_allocation_counters_enabled"), &LuaState::are_allocation_counters_enabled);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("reset_allocation_counters"), &LuaState::reset_allocation_counters);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("get_allocation_counters"), &LuaState::get_allocation_counters);
+	ClassDB::bind_static_method(LuaState::get_class_static(), D_METHOD("count_allocations", "callable"), &LuaState::count_allocations);
+#endif
 
 	// Properties
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "globals", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE, LuaTable::get_class_static()), "", "get_globals");
@@ -457,6 +752,11 @@ void LuaState::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "main_thread", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE, LuaThread::get_class_static()), "", "get_main_thread");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "package_path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "set_package_path", "get_package_path");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "package_cpath", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NONE), "set_package_cpath", "get_package_cpath");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "allocator", PROPERTY_HINT_ENUM, "Default,Pool"), "set_allocator", "get_allocator");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "memory_limit", PROPERTY_HINT_NONE, "suffix:B"), "set_memory_limit", "get_memory_limit");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "memory_soft_limit", PROPERTY_HINT_NONE, "suffix:B"), "set_memory_soft_limit", "get_memory_soft_limit");
+
+	ADD_SIGNAL(MethodInfo(string_names->memory_soft_limit_reached, PropertyInfo(Variant::INT, "memory_used")));
 }
 
 LuaState::operator String() const {
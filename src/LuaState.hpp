@@ -23,10 +23,14 @@
 #define __LUA_STATE_HPP__
 
 #include "utils/custom_sol.hpp"
+#include "utils/LuaAllocator.hpp"
+#include "utils/LuaSamplingProfiler.hpp"
 
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
 
+#include <memory>
+
 using namespace godot;
 
 namespace luagdextension {
@@ -102,6 +106,16 @@ public:
 		GC_MODE_GENERATIONAL = (int) sol::gc_mode::generational,
 	};
 
+	enum Allocator {
+		ALLOCATOR_DEFAULT = LuaAllocator::MODE_DEFAULT,
+		ALLOCATOR_POOL = LuaAllocator::MODE_POOL,
+	};
+
+	enum ProfileFormat {
+		PROFILE_FORMAT_FOLDED,
+		PROFILE_FORMAT_SPEEDSCOPE,
+	};
+
 	LuaState();
 	virtual ~LuaState();
 
@@ -138,9 +152,36 @@ public:
 	GcMode change_gc_mode_generational(int minor_multiplier, int major_multiplier);
 	bool supports_gc_mode(GcMode mode) const;
 
+	Allocator get_allocator() const;
+	void set_allocator(Allocator allocator);
+	Dictionary get_allocator_statistics() const;
+
+	int64_t get_memory_limit() const;
+	void set_memory_limit(int64_t bytes);
+	int64_t get_memory_soft_limit() const;
+	void set_memory_soft_limit(int64_t bytes);
+	uint64_t get_memory_peak() const;
+	void reset_memory_peak();
+	uint64_t get_gc_cycle_count() const;
+
+	void start_allocation_profiler(int64_t sample_interval_bytes = 16384);
+	void stop_allocation_profiler();
+	bool is_allocation_profiler_running() const;
+	Dictionary get_allocation_profile() const;
+	Error save_allocation_profile(const String& path, bool live_only = false) const;
+
+	LuaSamplingProfiler *get_sampling_profiler();
+	Dictionary get_sampling_profile() const;
+	Error save_sampling_profile(const String& path, ProfileFormat format = PROFILE_FORMAT_FOLDED) const;
+	void clear_sampling_profile();
+
+	void add_performance_monitors(const String& category);
+	void remove_performance_monitors();
+
 #ifdef HAVE_LUA_WARN
 	void warn(const char *msg, int tocont);
 #endif
+	void _on_memory_soft_limit_reached();
 
 	operator String() const;
 
@@ -149,6 +190,19 @@ public:
 	static String get_lua_version_string();
 
 	static String get_lua_exec_dir();
+	static void clear_module_resolution_cache();
+	static void clear_global_class_cache();
+	static void set_boundary_counters_enabled(bool enabled);
+	static bool are_boundary_counters_enabled();
+	static void reset_boundary_counters();
+	static Array get_boundary_counter_report();
+#ifdef DEBUG_ENABLED
+	static void set_allocation_counters_enabled(bool enabled);
+	static bool are_allocation_counters_enabled();
+	static void reset_allocation_counters();
+	static Dictionary get_allocation_counters();
+	static Dictionary count_allocations(const Callable& callable);
+#endif
 	static LuaState *find_lua_state(lua_State *L);
 
 protected:
@@ -156,6 +210,26 @@ protected:
 
 	String _to_string() const;
 
+	void setup_lua_state();
+
+	enum PerformanceMonitor {
+		MONITOR_MEMORY_USED,
+		MONITOR_MEMORY_PEAK,
+		MONITOR_GC_CYCLES,
+		MONITOR_MAX,
+	};
+	uint64_t get_performance_monitor(int monitor) const;
+	String performance_monitor_category;
+
+	// Declared before `lua_state`, so that it outlives the Lua state it serves
+	std::unique_ptr<LuaAllocator> allocator;
+	uint64_t gc_cycle_count = 0;
+	// Created by the first `LuaThread.start_sampling_profiler`
+	std::unique_ptr<LuaSamplingProfiler> sampling_profiler;
+#ifdef LUAJIT
+	lua_Alloc luajit_alloc;
+	void *luajit_alloc_ud;
+#endif
 	sol::state lua_state;
 #ifdef HAVE_LUA_WARN
 	bool warning_on = true;
@@ -170,5 +244,7 @@ private:
 VARIANT_BITFIELD_CAST(luagdextension::LuaState::Library);
 VARIANT_ENUM_CAST(luagdextension::LuaState::LoadMode);
 VARIANT_ENUM_CAST(luagdextension::LuaState::GcMode);
+VARIANT_ENUM_CAST(luagdextension::LuaState::Allocator);
+VARIANT_ENUM_CAST(luagdextension::LuaState::ProfileFormat);
 
 #endif
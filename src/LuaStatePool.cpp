@@ -0,0 +1,299 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaStatePool.hpp"
+
+#include "LuaThread.hpp"
+#include "utils/LuaCoroutinePool.hpp"
+#include "utils/LuaSamplingProfiler.hpp"
+#include "utils/stack_top_checker.hpp"
+
+#include <godot_cpp/classes/time.hpp>
+
+#include <vector>
+
+namespace luagdextension {
+
+constexpr char POOL_SNAPSHOT_KEY[] = "_GDEXTENSION_STATE_POOL_SNAPSHOT";
+
+static sol::table copy_table(sol::state_view& L, const sol::table& table, bool only_string_keys = false) {
+	sol::table copy = L.create_table();
+	for (auto& [key, value] : table) {
+		if (!only_string_keys || key.get_type() == sol::type::string) {
+			copy.raw_set(key, value);
+		}
+	}
+	return copy;
+}
+
+// Removes keys that are not in `snapshot` and restores the values of the ones that are.
+static void restore_table(sol::table& table, const sol::table& snapshot) {
+	// New keys cannot be assigned while traversing the table, so collect them first
+	std::vector<sol::object> added_keys;
+	for (auto& [key, value] : table) {
+		if (snapshot.raw_get<sol::object>(key).get_type() == sol::type::lua_nil) {
+			added_keys.push_back(key);
+		}
+	}
+	for (const sol::object& key : added_keys) {
+		table.raw_set(key, sol::lua_nil);
+	}
+	for (auto& [key, value] : snapshot) {
+		table.raw_set(key, value);
+	}
+}
+
+BitField<LuaState::Library> LuaStatePool::get_libraries() const {
+	return libraries;
+}
+
+void LuaStatePool::set_libraries(BitField<LuaState::Library> libraries) {
+	if (this->libraries != libraries) {
+		// Pooled states have the old libraries opened
+		available_states.clear();
+	}
+	this->libraries = libraries;
+}
+
+int LuaStatePool::get_max_size() const {
+	return max_size;
+}
+
+void LuaStatePool::set_max_size(int max_size) {
+	this->max_size = MAX(max_size, 0);
+	if (available_states.size() > this->max_size) {
+		available_states.resize(this->max_size);
+	}
+}
+
+int LuaStatePool::get_available_count() const {
+	return available_states.size();
+}
+
+void LuaStatePool::prewarm(int count) {
+	count = MIN(count, max_size);
+	while (available_states.size() < count) {
+		available_states.push_back(_create_state());
+	}
+}
+
+Ref<LuaState> LuaStatePool::acquire() {
+	if (available_states.is_empty()) {
+		miss_count++;
+		return _create_state();
+	}
+	else {
+		hit_count++;
+		Ref<LuaState> state = available_states[available_states.size() - 1];
+		available_states.remove_at(available_states.size() - 1);
+		return state;
+	}
+}
+
+bool LuaStatePool::release(const Ref<LuaState>& state) {
+	ERR_FAIL_COND_V(state.is_null(), false);
+	sol::state_view L = state->get_lua_state();
+	sol::optional<sol::table> snapshot = L.registry().raw_get<sol::optional<sol::table>>(POOL_SNAPSHOT_KEY);
+	ERR_FAIL_COND_V_MSG(!snapshot || snapshot->raw_get_or("pool", (uint64_t) 0) != get_instance_id(), false, "LuaState was not acquired from this pool.");
+	// States acquired before `libraries` changed have the old libraries opened
+	if (snapshot->raw_get_or("libraries", (int64_t) 0) != (int64_t) libraries) {
+		return false;
+	}
+	if (available_states.size() >= max_size || available_states.has(state)) {
+		return false;
+	}
+
+	uint64_t start_usec = Time::get_singleton()->get_ticks_usec();
+	_reset_state(state);
+	reset_last_usec = Time::get_singleton()->get_ticks_usec() - start_usec;
+	reset_total_usec += reset_last_usec;
+	reset_count++;
+
+	available_states.push_back(state);
+	return true;
+}
+
+void LuaStatePool::clear() {
+	available_states.clear();
+}
+
+Dictionary LuaStatePool::get_statistics() const {
+	Dictionary statistics;
+	statistics["hits"] = hit_count;
+	statistics["misses"] = miss_count;
+	statistics["resets"] = reset_count;
+	statistics["reset_total_usec"] = reset_total_usec;
+	statistics["reset_last_usec"] = reset_last_usec;
+	statistics["reset_average_usec"] = reset_count > 0 ? (double) reset_total_usec / reset_count : 0.0;
+	return statistics;
+}
+
+void LuaStatePool::reset_statistics() {
+	hit_count = 0;
+	miss_count = 0;
+	reset_count = 0;
+	reset_total_usec = 0;
+	reset_last_usec = 0;
+}
+
+Ref<LuaState> LuaStatePool::_create_state() const {
+	Ref<LuaState> state;
+	state.instantiate();
+	state->open_libraries(libraries);
+
+	sol::state_view L = state->get_lua_state();
+	StackTopChecker topcheck(L);
+	sol::table snapshot = L.create_table();
+	snapshot["pool"] = (uint64_t) get_instance_id();
+	snapshot["libraries"] = (int64_t) libraries;
+	sol::table globals = L.globals();
+	snapshot["globals"] = copy_table(L, globals);
+	snapshot["globals_metatable"] = globals[sol::metatable_key].get<sol::object>();
+	// Integer keys are references held by live objects, only named entries are part of the baseline
+	snapshot["registry"] = copy_table(L, L.registry(), true);
+	sol::optional<sol::table> loaded = L.registry().raw_get<sol::optional<sol::table>>("_LOADED");
+	if (loaded) {
+		snapshot["loaded"] = copy_table(L, *loaded);
+	}
+
+	// Library tables are restored one level deep, so that changes like `string.format = nil` don't leak to the next user.
+	// Tables inside `package`, like `package.searchers` and `package.preload`, are restored as well,
+	// along with the string metatable and named registry tables, like sol2's usertype metatables.
+	// Their metatables are restored too, since `setmetatable(string, ...)` would affect the next user.
+	sol::table library_tables = L.create_table();
+	sol::table library_metatables = L.create_table();
+	const void *loaded_pointer = loaded ? loaded->pointer() : nullptr;
+	auto snapshot_table = [&](const sol::object& value) {
+		if (value.get_type() == sol::type::table
+			&& value.pointer() != globals.pointer()
+			&& value.pointer() != loaded_pointer
+			&& library_tables.raw_get<sol::object>(value).get_type() == sol::type::lua_nil)
+		{
+			library_tables.raw_set(value, copy_table(L, value.as<sol::table>()));
+			sol::optional<sol::table> metatable = value.as<sol::table>()[sol::metatable_key];
+			library_metatables.raw_set(value, metatable ? sol::make_object(L, *metatable) : sol::make_object(L, false));
+		}
+	};
+	auto snapshot_table_fields = [&](const sol::table& table, bool only_string_keys = false) {
+		for (auto& [key, value] : table) {
+			if (!only_string_keys || key.get_type() == sol::type::string) {
+				snapshot_table(value);
+			}
+		}
+	};
+	snapshot_table_fields(globals);
+	if (sol::optional<sol::table> package = globals.raw_get<sol::optional<sol::table>>("package")) {
+		snapshot_table_fields(*package);
+	}
+	snapshot_table_fields(L.registry(), true);
+	lua_pushliteral(L, "");
+	if (lua_getmetatable(L, -1)) {
+		sol::object string_metatable(L, -1);
+		snapshot["string_metatable"] = string_metatable;
+		snapshot_table(string_metatable);
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+	snapshot["library_tables"] = library_tables;
+	snapshot["library_metatables"] = library_metatables;
+	L.registry().raw_set(POOL_SNAPSHOT_KEY, snapshot);
+	return state;
+}
+
+void LuaStatePool::_reset_state(const Ref<LuaState>& state) const {
+	sol::state_view L = state->get_lua_state();
+	StackTopChecker topcheck(L);
+	sol::table registry = L.registry();
+	sol::table snapshot = registry.raw_get<sol::table>(POOL_SNAPSHOT_KEY);
+
+	// Named registry entries may be replaced, but new ones are kept,
+	// since libraries like sol2 store usertype metatables there on demand
+	for (auto& [key, value] : snapshot.raw_get<sol::table>("registry")) {
+		registry.raw_set(key, value);
+	}
+
+	sol::table globals = L.globals();
+	restore_table(globals, snapshot.raw_get<sol::table>("globals"));
+	globals[sol::metatable_key] = snapshot.raw_get<sol::object>("globals_metatable");
+
+	if (sol::optional<sol::table> loaded_snapshot = snapshot.raw_get<sol::optional<sol::table>>("loaded")) {
+		sol::table loaded = registry.raw_get<sol::table>("_LOADED");
+		restore_table(loaded, *loaded_snapshot);
+	}
+
+	for (auto& [table, table_snapshot] : snapshot.raw_get<sol::table>("library_tables")) {
+		sol::table library_table = table.as<sol::table>();
+		restore_table(library_table, table_snapshot.as<sol::table>());
+	}
+	for (auto& [table, metatable] : snapshot.raw_get<sol::table>("library_metatables")) {
+		table.push();
+		if (metatable.get_type() == sol::type::table) {
+			metatable.push();
+		}
+		else {
+			lua_pushnil(L);
+		}
+		lua_setmetatable(L, -2);
+		lua_pop(L, 1);
+	}
+	lua_pushliteral(L, "");
+	snapshot.raw_get<sol::object>("string_metatable").push();
+	lua_setmetatable(L, -2);
+	lua_pop(L, 1);
+
+	// Hooks and profilers set by the previous user must not run for the next one.
+	// Pooled coroutines inherited the main thread's hooks, so they are dropped as well.
+	state->get_main_thread()->set_hook(Variant(), 0);
+	state->stop_allocation_profiler();
+	state->get_sampling_profiler()->stop_all_threads();
+	state->clear_sampling_profile();
+	LuaCoroutinePool(L).clear();
+
+	state->set_memory_limit(0);
+	state->set_memory_soft_limit(0);
+
+	// Free everything the previous user left behind, so the state is handed out with a clean heap
+	L.collect_garbage();
+	state->reset_memory_peak();
+}
+
+void LuaStatePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_libraries"), &LuaStatePool::get_libraries);
+	ClassDB::bind_method(D_METHOD("set_libraries", "libraries"), &LuaStatePool::set_libraries);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &LuaStatePool::get_max_size);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &LuaStatePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &LuaStatePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &LuaStatePool::prewarm);
+	ClassDB::bind_method(D_METHOD("acquire"), &LuaStatePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "state"), &LuaStatePool::release);
+	ClassDB::bind_method(D_METHOD("clear"), &LuaStatePool::clear);
+	ClassDB::bind_method(D_METHOD("get_statistics"), &LuaStatePool::get_statistics);
+	ClassDB::bind_method(D_METHOD("reset_statistics"), &LuaStatePool::reset_statistics);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "libraries"), "set_libraries", "get_libraries");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_max_size", "get_max_size");
+}
+
+String LuaStatePool::_to_string() const {
+	return String("[%s:%d]") % Array::make(get_class_static(), get_instance_id());
+}
+
+}
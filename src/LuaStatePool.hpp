@@ -0,0 +1,78 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_STATE_POOL_HPP__
+#define __LUA_STATE_POOL_HPP__
+
+#include "LuaState.hpp"
+
+#include <godot_cpp/templates/vector.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Pool of pre-initialized Lua states.
+ *
+ * Released states are reset to the snapshot taken right after opening their libraries,
+ * which is cheaper than creating and initializing new states.
+ */
+class LuaStatePool : public RefCounted {
+	GDCLASS(LuaStatePool, RefCounted);
+
+public:
+	BitField<LuaState::Library> get_libraries() const;
+	void set_libraries(BitField<LuaState::Library> libraries);
+	int get_max_size() const;
+	void set_max_size(int max_size);
+	int get_available_count() const;
+
+	void prewarm(int count);
+	Ref<LuaState> acquire();
+	bool release(const Ref<LuaState>& state);
+	void clear();
+
+	Dictionary get_statistics() const;
+	void reset_statistics();
+
+protected:
+	static void _bind_methods();
+	String _to_string() const;
+
+private:
+	Ref<LuaState> _create_state() const;
+	void _reset_state(const Ref<LuaState>& state) const;
+
+	BitField<LuaState::Library> libraries = LuaState::ALL_LIBS;
+	int max_size = 8;
+	Vector<Ref<LuaState>> available_states;
+
+	uint64_t hit_count = 0;
+	uint64_t miss_count = 0;
+	uint64_t reset_count = 0;
+	uint64_t reset_total_usec = 0;
+	uint64_t reset_last_usec = 0;
+};
+
+}
+
+#endif  // __LUA_STATE_POOL_HPP__
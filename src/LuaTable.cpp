@@ -36,41 +36,66 @@ LuaTable::LuaTable() : LuaObjectSubclass() {}
 LuaTable::LuaTable(sol::table&& table) : LuaObjectSubclass(table) {}
 LuaTable::LuaTable(const sol::table& table) : LuaObjectSubclass(table) {}
 
-sol::optional<Variant> LuaTable::try_get(const Variant& key, bool raw) const {
-	StackTopChecker topcheck(lua_object.lua_state());
-	lua_State *L = lua_object.lua_state();
-	sol::stack::push(L, lua_object);
-	lua_push(L, key);
-	if (raw) {
-		lua_rawget(L, -2);
+// Table accesses from Godot run in protected mode, since pushing keys and values
+// may fail under `LuaState.memory_limit` and metamethods may raise errors
+struct ProtectedTableAccess {
+	const sol::table *table;
+	const Variant *key;
+	const Variant *value;
+	bool raw;
+	sol::optional<Variant> result;
+};
+
+static int protected_table_access(lua_State *L) {
+	ProtectedTableAccess *access = (ProtectedTableAccess *) lua_touserdata(L, 1);
+	sol::stack::push(L, *access->table);
+	lua_push(L, *access->key);
+	if (access->value) {
+		lua_push(L, *access->value);
+		if (access->raw) {
+			lua_rawset(L, -3);
+		}
+		else {
+			lua_settable(L, -3);
+		}
 	}
 	else {
-		lua_gettable(L, -2);
+		if (access->raw) {
+			lua_rawget(L, -2);
+		}
+		else {
+			lua_gettable(L, -2);
+		}
+		if (!lua_isnoneornil(L, -1)) {
+			access->result = to_variant(L, -1);
+		}
 	}
-	auto _ = sol::stack::pop_n(L, 2);
-	if (lua_isnoneornil(L, -1)) {
-		return std::nullopt;
-	}
-	else {
-		return to_variant(L, -1);
+	return 0;
+}
+
+static bool run_protected_table_access(lua_State *L, ProtectedTableAccess& access) {
+	StackTopChecker topcheck(L);
+	lua_pushcfunction(L, protected_table_access);
+	lua_pushlightuserdata(L, &access);
+	if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+		String message = luaL_tolstring(L, -1, nullptr);
+		lua_pop(L, 2);
+		ERR_FAIL_V_MSG(false, message);
 	}
+	return true;
+}
+
+sol::optional<Variant> LuaTable::try_get(const Variant& key, bool raw) const {
+	ProtectedTableAccess access { &lua_object, &key, nullptr, raw };
+	run_protected_table_access(lua_object.lua_state(), access);
+	return access.result;
 }
 
 bool LuaTable::try_set(const Variant& key, const Variant& value, bool raw) {
 	ERR_FAIL_COND_V_MSG(key == Variant(), false, "Table key cannot be null");
-	
-	StackTopChecker topcheck(lua_object.lua_state());
-	lua_State *L = lua_object.lua_state();
-	auto table_popper = sol::stack::push_pop(L, lua_object);
-	lua_push(L, key);
-	lua_push(L, value);
-	if (raw) {
-		lua_rawset(L, -3);
-	}
-	else {
-		lua_settable(L, -3);
-	}
-	return true;
+
+	ProtectedTableAccess access { &lua_object, &key, &value, raw };
+	return run_protected_table_access(lua_object.lua_state(), access);
 }
 
 Variant LuaTable::get(const Variant& key, const Variant& default_value) const {
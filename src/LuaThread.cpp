@@ -22,6 +22,7 @@
 #include "LuaThread.hpp"
 #include "LuaDebug.hpp"
 #include "LuaFunction.hpp"
+#include "LuaState.hpp"
 #include "utils/convert_godot_lua.hpp"
 #include "utils/stack_top_checker.hpp"
 
@@ -49,6 +50,17 @@ static void hookf(lua_State *L, lua_Debug *ar) {
 	}
 }
 
+static void sampling_hookf(lua_State *L, lua_Debug *ar) {
+	LuaState *state = LuaState::find_lua_state(L);
+	if (state && state->get_sampling_profiler()->is_running()) {
+		state->get_sampling_profiler()->sample(L);
+	}
+	else {
+		// Inherited from a thread that stopped sampling
+		lua_sethook(L, nullptr, 0, 0);
+	}
+}
+
 LuaThread::LuaThread() : LuaObjectSubclass() {}
 LuaThread::LuaThread(sol::thread&& thread) : LuaObjectSubclass(thread) {}
 LuaThread::LuaThread(const sol::thread& thread) : LuaObjectSubclass(thread) {}
@@ -119,6 +131,36 @@ int LuaThread::get_hook_count() const {
 	return lua_gethookcount(lua_object.thread_state());
 }
 
+void LuaThread::start_sampling_profiler(int instruction_interval) {
+	ERR_FAIL_COND_MSG(instruction_interval <= 0, "Instruction interval must be positive");
+	lua_State *L = lua_object.thread_state();
+	LuaState *state = LuaState::find_lua_state(L);
+	ERR_FAIL_NULL_MSG(state, "Sampling profiler is only supported in threads from a LuaState");
+	// Replaces any hook set by `set_hook`
+	set_hook(Variant(), 0);
+	state->get_sampling_profiler()->start_thread(L);
+	lua_sethook(L, sampling_hookf, LUA_MASKCOUNT, instruction_interval);
+}
+
+void LuaThread::stop_sampling_profiler() {
+	lua_State *L = lua_object.thread_state();
+	if (lua_gethook(L) == sampling_hookf) {
+		lua_sethook(L, nullptr, 0, 0);
+	}
+	if (LuaState *state = LuaState::find_lua_state(L)) {
+		state->get_sampling_profiler()->stop_thread(L);
+	}
+}
+
+bool LuaThread::is_sampling_profiler_running() const {
+	lua_State *L = lua_object.thread_state();
+	if (lua_gethook(L) != sampling_hookf) {
+		return false;
+	}
+	LuaState *state = LuaState::find_lua_state(L);
+	return state && state->get_sampling_profiler()->is_running();
+}
+
 Ref<LuaDebug> LuaThread::get_stack_level_info(int stack_level) const {
 	lua_State *L = lua_object.thread_state();
 	lua_Debug debug = {};
@@ -186,6 +228,10 @@ void LuaThread::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_hook"), &LuaThread::get_hook);
 	ClassDB::bind_method(D_METHOD("get_hook_mask"), &LuaThread::get_hook_mask);
 	ClassDB::bind_method(D_METHOD("get_hook_count"), &LuaThread::get_hook_count);
+
+	ClassDB::bind_method(D_METHOD("start_sampling_profiler", "instruction_interval"), &LuaThread::start_sampling_profiler, DEFVAL(1000));
+	ClassDB::bind_method(D_METHOD("stop_sampling_profiler"), &LuaThread::stop_sampling_profiler);
+	ClassDB::bind_method(D_METHOD("is_sampling_profiler_running"), &LuaThread::is_sampling_profiler_running);
 	
 	ClassDB::bind_method(D_METHOD("get_stack_level_info", "level"), &LuaThread::get_stack_level_info);
 	ClassDB::bind_method(D_METHOD("get_stack_info"), &LuaThread::get_stack_info);
@@ -82,6 +82,10 @@ public:
 	BitField<HookMask> get_hook_mask() const;
 	int get_hook_count() const;
 
+	void start_sampling_profiler(int instruction_interval = 1000);
+	void stop_sampling_profiler();
+	bool is_sampling_profiler_running() const;
+
 	Ref<LuaDebug> get_stack_level_info(int stack_level) const;
 	TypedArray<LuaDebug> get_stack_info() const;
 	String get_traceback(String message = "", int level = 0) const;
@@ -22,9 +22,7 @@
 
 #include "../utils/Class.hpp"
 #include "../utils/module_names.hpp"
-#include "../utils/convert_godot_std.hpp"
 
-#include <godot_cpp/classes/project_settings.hpp>
 #include <sol/sol.hpp>
 
 using namespace luagdextension;
@@ -32,15 +30,9 @@ using namespace luagdextension;
 extern "C" int luaopen_godot_classes(lua_State *L) {
 	sol::state_view state = L;
 
+	// Classes and script global classes are found on demand by `_G`'s `__index` metamethod
 	state.registry()[module_names::classes] = true;
-	sol::table global_class_paths = state.registry().create_named("_GDEXTENSION_GLOBAL_CLASS_PATHS");
 	Class::register_usertype(state);
 
-	TypedArray<Dictionary> global_class_list = ProjectSettings::get_singleton()->get_global_class_list();
-	for (int64_t i = 0; i < global_class_list.size(); ++i) {
-		Dictionary type_info = global_class_list[i];
-		global_class_paths[to_std_string(type_info["class"])] = to_std_string(type_info["path"]);
-	}
-
 	return 0;
 }
@@ -19,15 +19,30 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#include "godot.hpp"
+
 #include "../generated/global_enums.hpp"
+#include "../utils/module_names.hpp"
 
 #include <sol/sol.hpp>
 
+using namespace luagdextension;
+
+bool luagdextension::define_lazy_enum(lua_State *L, std::string_view name) {
+	if (const int64_t *value = perfect_hash_find(global_enum_entries, global_enum_seeds, name)) {
+		sol::state_view(L).set(name, *value);
+		return true;
+	}
+	else {
+		return false;
+	}
+}
+
 extern "C" int luaopen_godot_enums(lua_State *L) {
 	sol::state_view state = L;
 
-	register_global_enums(state);
+	// Thousands of enum values are defined on demand, see `define_lazy_enum`
+	state.registry()[module_names::enums] = true;
 
 	return 0;
 }
-
@@ -22,6 +22,8 @@
 #ifndef __LUAOPEN_GODOT_HPP__
 #define __LUAOPEN_GODOT_HPP__
 
+#include <string_view>
+
 struct lua_State;
 
 extern "C" {
@@ -36,4 +38,14 @@ int luaopen_godot_local_paths(lua_State *L);
 
 }
 
+namespace luagdextension {
+
+// Globals from these libraries are defined lazily by `_G`'s `__index` metamethod.
+// Each function returns whether `name` was defined as a global.
+bool define_lazy_variant_type(lua_State *L, std::string_view name);
+bool define_lazy_utility_function(lua_State *L, std::string_view name);
+bool define_lazy_enum(lua_State *L, std::string_view name);
+
+}
+
 #endif  // __LUAOPEN_GODOT_HPP__
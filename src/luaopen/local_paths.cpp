@@ -20,30 +20,87 @@
  * SOFTWARE.
  */
 
+#include "../LuaState.hpp"
 #include "../LuaTable.hpp"
 #include "../generated/package_searcher.h"
 #include "../utils/convert_godot_lua.hpp"
 #include "../utils/load_fileaccess.hpp"
+#include "../utils/module_resolution_cache.hpp"
+
+#include <godot_cpp/classes/os.hpp>
 
-#include <godot_cpp/classes/file_access.hpp>
 #include <luaconf.h>
 
 using namespace luagdextension;
 
+constexpr char SEARCHPATH_CACHE_KEY[] = "_GDEXTENSION_SEARCHPATH_CACHE";
+
+// Cache of module name -> resolved filename (or false, if not found) for the specified search path.
+// Only results that depend exclusively on read-only files are stored, see `is_cacheable_module_path`.
+// Changing `package.path` or `package.cpath` uses a new cache, while old ones are kept until the next global invalidation.
+static sol::table get_searchpath_cache(sol::state_view& state, const char *path, const char *sep, const char *rep) {
+	sol::table registry = state.registry();
+	uint32_t generation = get_module_resolution_generation();
+	sol::optional<sol::table> caches = registry.raw_get<sol::optional<sol::table>>(SEARCHPATH_CACHE_KEY);
+	if (!caches || caches->raw_get_or("generation", (uint32_t) 0) != generation) {
+		caches = state.create_table_with("generation", generation);
+		registry.raw_set(SEARCHPATH_CACHE_KEY, *caches);
+	}
+
+	std::string cache_key = std::string(path) + '\1' + sep + '\1' + rep;
+	sol::optional<sol::table> cache = caches->raw_get<sol::optional<sol::table>>(cache_key);
+	if (!cache) {
+		cache = state.create_table();
+		caches->raw_set(cache_key, *cache);
+	}
+	return *cache;
+}
+
+// `res://` is read-only in exported projects and rescanned by the editor.
+// In exported projects, files next to the executable (`!` in search paths) are also shipped with the game.
+// Results that depend on other locations like `user://` are never cached, allowing runtime mods to be found.
+static bool is_cacheable_module_path(const String& filename) {
+	if (filename.begins_with("res://")) {
+		return true;
+	}
+	static bool is_exported = OS::get_singleton()->has_feature("template");
+	static String exec_dir = LuaState::get_lua_exec_dir().path_join("");
+	return is_exported && filename.begins_with(exec_dir);
+}
+
 static int l_searchpath(lua_State *L) {
-	String name = luaL_checkstring(L, 1);
-	String path = luaL_checkstring(L, 2);
-	String sep = luaL_optstring(L, 3, ".");
-	String rep = luaL_optstring(L, 4, "/");
+	const char *name_chars = luaL_checkstring(L, 1);
+	const char *path_chars = luaL_checkstring(L, 2);
+	const char *sep_chars = luaL_optstring(L, 3, ".");
+	const char *rep_chars = luaL_optstring(L, 4, "/");
+
+	sol::state_view state(L);
+	sol::table cache = get_searchpath_cache(state, path_chars, sep_chars, rep_chars);
+	sol::object cached = cache.raw_get<sol::object>(name_chars);
+	if (cached.get_type() == sol::type::string) {
+		sol::stack::push(L, cached);
+		return 1;
+	}
+	bool is_known_missing = cached.get_type() == sol::type::boolean;
+
+	String name = name_chars;
+	String path = path_chars;
+	String sep = sep_chars;
+	String rep = rep_chars;
 	if (!sep.is_empty()) {
 		name = name.replace(sep, rep);
 	}
 	
 	PackedStringArray path_list = path.split(LUA_PATH_SEP, false);
 	PackedStringArray not_found_list;
+	bool is_cacheable = true;
 	for (const String& path_template : path_list) {
 		String filename = path_template.replace(LUA_PATH_MARK, name);
-		if (FileAccess::file_exists(filename)) {
+		is_cacheable = is_cacheable && is_cacheable_module_path(filename);
+		if (!is_known_missing && module_file_exists(filename)) {
+			if (is_cacheable) {
+				cache.raw_set(name_chars, filename);
+			}
 			sol::stack::push(L, filename);
 			return 1;
 		}
@@ -51,6 +108,9 @@ static int l_searchpath(lua_State *L) {
 			not_found_list.append(filename);
 		}
 	}
+	if (is_cacheable) {
+		cache.raw_set(name_chars, false);
+	}
 
 	// path not found, return a formatted error message
 	String error_message;
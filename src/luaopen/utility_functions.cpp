@@ -19,10 +19,12 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
-#include "../generated/utility_functions.hpp"
+#include "godot.hpp"
+
 #include "../utils/VariantArguments.hpp"
 #include "../utils/extra_utility_functions.hpp"
 #include "../utils/function_wrapper.hpp"
+#include "../utils/module_names.hpp"
 #include "../utils/string_literal.hpp"
 #include "../utils/string_names.hpp"
 #include "../LuaCoroutine.hpp"
@@ -133,14 +135,30 @@ static int lua_await(lua_State *L) {
 	return lua_yield(L, 0);
 }
 
+// Depends on `_call_variadic_utility_function`
+#include "../generated/utility_functions.hpp"
+
+bool luagdextension::define_lazy_utility_function(lua_State *L, std::string_view name) {
+	if (const UtilityFunctionRegistrar *registrar = perfect_hash_find(utility_function_entries, utility_function_seeds, name)) {
+		sol::state_view state = L;
+		(*registrar)(state);
+		return true;
+	}
+	else {
+		return false;
+	}
+}
+
 extern "C" int luaopen_godot_utility_functions(lua_State *L) {
 	sol::state_view state = L;
 
-	register_utility_functions(state);
+	// Most utility functions are defined on demand, see `define_lazy_utility_function`
+	state.registry()[module_names::utility_functions] = true;
 	state.set("is_instance_valid", wrap_function(L, &is_instance_valid));
 
 	// In Lua, `print` separates passed values with "\t", so we bind it to Godot's `printt`
-	state.do_string("print = printt");
+	define_lazy_utility_function(L, "printt");
+	state["print"] = state["printt"];
 
 	// Use `await` to await for signals.
 	state.set("await", lua_await);
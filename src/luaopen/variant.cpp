@@ -26,6 +26,9 @@
 #include <godot_cpp/variant/variant.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 
+#include "godot.hpp"
+
+#include "../generated/variant_types.hpp"
 #include "../utils/Class.hpp"
 #include "../utils/DictionaryIterator.hpp"
 #include "../utils/IndexedIterator.hpp"
@@ -34,8 +37,10 @@
 #include "../utils/VariantType.hpp"
 #include "../utils/convert_godot_lua.hpp"
 #include "../utils/convert_godot_std.hpp"
+#include "../utils/boundary_counters.hpp"
 #include "../utils/function_wrapper.hpp"
 #include "../utils/method_bind_impl.hpp"
+#include "../utils/module_names.hpp"
 #include "../utils/string_names.hpp"
 
 using namespace godot;
@@ -44,6 +49,7 @@ namespace luagdextension {
 
 template<Variant::Operator VarOperator>
 sol::object evaluate_binary_operator(sol::this_state state, const sol::stack_object& a, const sol::stack_object& b) {
+	count_binary_operator(VarOperator);
 	bool is_valid;
 	Variant result;
 	Variant var_a = to_variant(a);
@@ -98,6 +104,9 @@ sol::object variant__index(sol::this_state state, const Variant& variant, const
 	bool is_valid;
 	if (key.get_type() == sol::type::string) {
 		StringName string_name = key.as<StringName>();
+		if (are_boundary_counters_enabled()) {
+			record_boundary_member(BOUNDARY_VARIANT_INDEX, variant, string_name);
+		}
 		if (Variant::has_member(variant.get_type(), string_name)) {
 			return to_lua(state, variant.get_named(string_name, is_valid));
 		}
@@ -106,6 +115,10 @@ sol::object variant__index(sol::this_state state, const Variant& variant, const
 		}
 	}
 
+	else if (are_boundary_counters_enabled()) {
+		record_boundary_key(BOUNDARY_VARIANT_INDEX, Variant::get_type_name(variant.get_type()) + "[" + lua_typename(key.lua_state(), (int) key.get_type()) + "]");
+	}
+
 	Variant result = variant.get(to_variant(key), &is_valid);
 	return to_lua(state, result);
 }
@@ -191,6 +204,16 @@ void variant__close(Variant& variant) {
 
 using namespace luagdextension;
 
+bool luagdextension::define_lazy_variant_type(lua_State *L, std::string_view name) {
+	if (const Variant::Type *type = perfect_hash_find(variant_type_entries, variant_type_seeds, name)) {
+		sol::state_view(L).set(name, VariantType(*type));
+		return true;
+	}
+	else {
+		return false;
+	}
+}
+
 extern "C" int luaopen_godot_variant(lua_State *L) {
 	sol::state_view state = L;
 
@@ -253,53 +276,12 @@ extern "C" int luaopen_godot_variant(lua_State *L) {
 
 	state.set("typeof", &variant_get_type);
 
-	// atomic types
-	state.set("bool", VariantType(Variant::BOOL));
-	state.set("int", VariantType(Variant::INT));
-	state.set("float", VariantType(Variant::FLOAT));
-	state.set("String", VariantType(Variant::STRING));
+	// Variant types are defined on demand, see `define_lazy_variant_type`
+	state.registry()[module_names::variant] = true;
+
 	// Add String methods as a fallback for Lua strings
 	state.do_string("if string then setmetatable(string, { __index = String }) end");
 
-	// math types
-	state.set("Vector2", VariantType(Variant::VECTOR2));
-	state.set("Vector2i", VariantType(Variant::VECTOR2I));
-	state.set("Rect2", VariantType(Variant::RECT2));
-	state.set("Rect2i", VariantType(Variant::RECT2I));
-	state.set("Vector3", VariantType(Variant::VECTOR3));
-	state.set("Vector3i", VariantType(Variant::VECTOR3I));
-	state.set("Transform2D", VariantType(Variant::TRANSFORM2D));
-	state.set("Vector4", VariantType(Variant::VECTOR4));
-	state.set("Vector4i", VariantType(Variant::VECTOR4I));
-	state.set("Plane", VariantType(Variant::PLANE));
-	state.set("Quaternion", VariantType(Variant::QUATERNION));
-	state.set("AABB", VariantType(Variant::AABB));
-	state.set("Basis", VariantType(Variant::BASIS));
-	state.set("Transform3D", VariantType(Variant::TRANSFORM3D));
-	state.set("Projection", VariantType(Variant::PROJECTION));
-
-	// misc types
-	state.set("Color", VariantType(Variant::COLOR));
-	state.set("StringName", VariantType(Variant::STRING_NAME));
-	state.set("NodePath", VariantType(Variant::NODE_PATH));
-	state.set("RID", VariantType(Variant::RID));
-	state.set("Callable", VariantType(Variant::CALLABLE));
-	state.set("Signal", VariantType(Variant::SIGNAL));
-	state.set("Dictionary", VariantType(Variant::DICTIONARY));
-	state.set("Array", VariantType(Variant::ARRAY));
-
-	// typed arrays
-	state.set("PackedByteArray", VariantType(Variant::PACKED_BYTE_ARRAY));
-	state.set("PackedInt32Array", VariantType(Variant::PACKED_INT32_ARRAY));
-	state.set("PackedInt64Array", VariantType(Variant::PACKED_INT64_ARRAY));
-	state.set("PackedFloat32Array", VariantType(Variant::PACKED_FLOAT32_ARRAY));
-	state.set("PackedFloat64Array", VariantType(Variant::PACKED_FLOAT64_ARRAY));
-	state.set("PackedStringArray", VariantType(Variant::PACKED_STRING_ARRAY));
-	state.set("PackedVector2Array", VariantType(Variant::PACKED_VECTOR2_ARRAY));
-	state.set("PackedVector3Array", VariantType(Variant::PACKED_VECTOR3_ARRAY));
-	state.set("PackedColorArray", VariantType(Variant::PACKED_COLOR_ARRAY));
-	state.set("PackedVector4Array", VariantType(Variant::PACKED_VECTOR4_ARRAY));
-
 	return 0;
 }
 
@@ -29,17 +29,22 @@
 #include "LuaASTNode.hpp"
 #include "LuaASTQuery.hpp"
 #include "LuaObject.hpp"
+#include "LuaPreloadManifest.hpp"
 #include "LuaState.hpp"
+#include "LuaStatePool.hpp"
 #include "LuaTable.hpp"
 #include "LuaThread.hpp"
 #include "LuaUserdata.hpp"
 #include "script-language/LuaCodeEdit.hpp"
 #include "script-language/LuaScript.hpp"
+#include "script-language/LuaScriptBytecodeArchive.hpp"
+#include "script-language/LuaScriptExportPlugin.hpp"
 #include "script-language/LuaScriptImportBehaviorManager.hpp"
 #include "script-language/LuaScriptLanguage.hpp"
 #include "script-language/LuaScriptResourceFormatLoader.hpp"
 #include "script-language/LuaScriptResourceFormatSaver.hpp"
 #include "script-language/LuaSyntaxHighlighter.hpp"
+#include "utils/allocation_counters.hpp"
 #include "utils/project_settings.hpp"
 #include "utils/string_names.hpp"
 
@@ -51,10 +56,19 @@ using namespace godot;
 using namespace luagdextension;
 
 static void initialize(ModuleInitializationLevel level) {
+#ifdef DEBUG_ENABLED
+	if (level == MODULE_INITIALIZATION_LEVEL_EDITOR) {
+		ClassDB::register_class<LuaScriptExportPlugin>();
+		return;
+	}
+#endif
 	if (level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
 
+#ifdef DEBUG_ENABLED
+	install_allocation_counters();
+#endif
 	string_names = memnew(struct string_names());
 
 	// Lua object wrappers
@@ -71,6 +85,8 @@ static void initialize(ModuleInitializationLevel level) {
 	ClassDB::register_abstract_class<LuaDebug>();
 	ClassDB::register_class<LuaError>();
 	ClassDB::register_class<LuaState>();
+	ClassDB::register_class<LuaStatePool>();
+	ClassDB::register_class<LuaPreloadManifest>();
 
 	// Parser stuff
 	ClassDB::register_abstract_class<LuaASTNode>();
@@ -86,6 +102,7 @@ static void initialize(ModuleInitializationLevel level) {
 	ClassDB::register_abstract_class<LuaScriptResourceFormatLoader>();
 	ClassDB::register_abstract_class<LuaScriptResourceFormatSaver>();
 	LuaScriptImportBehaviorManager::get_or_create_singleton();
+	LuaScriptBytecodeArchive::get_or_create_singleton();
 	LuaScriptLanguage::get_or_create_singleton();
 	LuaScriptResourceFormatLoader::register_in_godot();
 	LuaScriptResourceFormatSaver::register_in_godot();
@@ -104,6 +121,7 @@ static void deinitialize(ModuleInitializationLevel level) {
 	LuaScriptResourceFormatSaver::unregister_in_godot();
 	LuaScriptResourceFormatLoader::unregister_in_godot();
 	LuaScriptLanguage::delete_singleton();
+	LuaScriptBytecodeArchive::delete_singleton();
 	LuaScriptImportBehaviorManager::delete_singleton();
 
 	memdelete(string_names);
@@ -21,6 +21,8 @@
  */
 #include "LuaScript.hpp"
 
+#include "LuaScriptBytecodeArchive.hpp"
+#include "LuaScriptBytecodeCache.hpp"
 #include "LuaScriptImportBehaviorManager.hpp"
 #include "LuaScriptInstance.hpp"
 #include "LuaScriptLanguage.hpp"
@@ -44,17 +46,28 @@
 #include "godot_cpp/core/error_macros.hpp"
 #include "godot_cpp/classes/engine.hpp"
 #include "godot_cpp/classes/global_constants.hpp"
+#include "godot_cpp/classes/node.hpp"
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/classes/resource_loader.hpp"
+#include "godot_cpp/classes/worker_thread_pool.hpp"
+#include "godot_cpp/variant/utility_functions.hpp"
 
 namespace luagdextension {
 
 LuaScript::LuaScript()
 	: ScriptExtension()
+	, analyzed_looks_like_godot_script(-1)
+	, instance_pool_size(0)
 {
 	placeholders.insert(this, {});
 }
 
 LuaScript::~LuaScript() {
+	_trim_instance_pool(0);
 	placeholders.erase(this);
+	if (base_script.is_valid()) {
+		base_script->inheriting_scripts.erase(this);
+	}
 }
 
 bool LuaScript::_editor_can_reload_from_file() {
@@ -70,7 +83,7 @@ bool LuaScript::_can_instantiate() const {
 }
 
 Ref<Script> LuaScript::_get_base_script() const {
-	return {};
+	return base_script;
 }
 
 StringName LuaScript::_get_global_name() const {
@@ -78,6 +91,11 @@ StringName LuaScript::_get_global_name() const {
 }
 
 bool LuaScript::_inherits_script(const Ref<Script> &script) const {
+	for (const LuaScript *s = this; s; s = s->base_script.ptr()) {
+		if (s == script.ptr()) {
+			return true;
+		}
+	}
 	return false;
 }
 
@@ -103,7 +121,8 @@ void *LuaScript::_placeholder_instance_create(Object *for_object) const {
 }
 
 bool LuaScript::_instance_has(Object *p_object) const {
-	return LuaScriptInstance::attached_to_object(p_object);
+	LuaScriptInstance *instance = LuaScriptInstance::attached_to_object(p_object);
+	return instance && instance->script.ptr() == this;
 }
 
 bool LuaScript::_has_source_code() const {
@@ -116,47 +135,110 @@ String LuaScript::_get_source_code() const {
 
 void LuaScript::_set_source_code(const String &code) {
 	source_code = code;
+	source_code_utf8 = PackedByteArray();
+	precompiled_bytecode = PackedByteArray();
+	analyzed_looks_like_godot_script = -1;
 	_reload(true);
 }
 
+void LuaScript::set_source_code_utf8(const PackedByteArray& source_utf8) {
+	source_code = source_utf8.get_string_from_utf8();
+	source_code_utf8 = source_utf8;
+	precompiled_bytecode = PackedByteArray();
+	analyzed_looks_like_godot_script = -1;
+}
+
 Error LuaScript::_reload(bool keep_state) {
 	placeholder_fallback_enabled = true;
+	PackedByteArray source_utf8 = source_code_utf8;
+	PackedByteArray bytecode = precompiled_bytecode;
+	source_code_utf8 = PackedByteArray();
+	precompiled_bytecode = PackedByteArray();
+
+	// Precompiled scripts may not ship their source code, so trust the flag decided on export
+	LuaScriptBytecodeArchive *archive = LuaScriptBytecodeArchive::get_singleton();
+	bool evaluate = archive && archive->has_file(get_path())
+		? archive->is_script(get_path())
+		: should_evaluate();
+	if (!evaluate) {
+		return OK;
+	}
 
-	ImportBehavior import_behavior = get_import_behavior();
-	switch (import_behavior) {
-		case IMPORT_BEHAVIOR_AUTOMATIC:
-			if (get_looks_like_godot_script()) {
-				break;
-			}
-			else {
-				return OK;
+	if (source_utf8.is_empty() && bytecode.is_empty()) {
+		source_utf8 = source_code.to_utf8_buffer();
+	}
+
+	bool has_metadata = false;
+	{
+		// Scripts may be loaded from multiple threads, but the shared Lua state is not thread-safe
+		MutexLock lock(LuaScriptLanguage::get_singleton()->get_lua_state_mutex());
+		Variant result = _load_source(source_utf8, bytecode);
+		if (LuaError *error = Object::cast_to<LuaError>(result)) {
+			if (!Engine::get_singleton()->is_editor_hint()) {
+				ERR_PRINT(error->get_message());
 			}
+			return ERR_PARSE_ERROR;
+		}
 
-		case IMPORT_BEHAVIOR_DONT_LOAD:
-			return OK;
+		result = Object::cast_to<LuaFunction>(result)->invokev(Array());
+		if (LuaError *error = Object::cast_to<LuaError>(result)) {
+			ERR_PRINT(result);
+		}
+		else if (LuaTable *table = Object::cast_to<LuaTable>(result)) {
+			placeholder_fallback_enabled = false;
+			own_metadata.clear();
+			own_metadata.setup(table->get_table());
+			has_metadata = true;
+		}
+	}
 
-		default:
-			break;
+	// Loading the base script may wait for other threads, so it must happen without holding the lock
+	if (has_metadata) {
+		_set_base_script(own_metadata.base_script_path);
+		_update_metadata();
+	}
+	return OK;
+}
+
+void LuaScript::precompile(bool use_sub_threads) {
+	String path = get_path();
+	LuaScriptBytecodeArchive *archive = LuaScriptBytecodeArchive::get_singleton();
+	if (archive && archive->has_file(path)) {
+		return;
 	}
 
-	Variant result = LuaScriptLanguage::get_singleton()->get_lua_state()->load_string(source_code, get_path());
-	if (LuaError *error = Object::cast_to<LuaError>(result)) {
-		if (!Engine::get_singleton()->is_editor_hint()) {
-			ERR_PRINT(error->get_message());
+	if (source_code_utf8.is_empty()) {
+		source_code_utf8 = source_code.to_utf8_buffer();
+	}
+
+	// Source analysis runs tree-sitter and is independent from compilation, so they may run in parallel
+	WorkerThreadPool::TaskID analysis_task = -1;
+	if (get_import_behavior() == IMPORT_BEHAVIOR_AUTOMATIC) {
+		if (use_sub_threads) {
+			analysis_task = WorkerThreadPool::get_singleton()->add_task(callable_mp(this, &LuaScript::_analyze_source_in_thread), false, "Analyze Lua script");
+		}
+		else {
+			_analyze_source_in_thread();
 		}
-		return ERR_PARSE_ERROR;
 	}
 
-	result = Object::cast_to<LuaFunction>(result)->invokev(Array());
-	if (LuaError *error = Object::cast_to<LuaError>(result)) {
-		ERR_PRINT(result);
+	bool use_cache = !path.is_empty() && LuaScriptBytecodeCache::is_enabled();
+	PackedByteArray source_hash;
+	if (use_cache) {
+		source_hash = LuaScriptBytecodeCache::hash_source(source_code_utf8);
+		precompiled_bytecode = LuaScriptBytecodeCache::load(path, source_hash);
+	}
+	if (precompiled_bytecode.is_empty()) {
+		// Compile errors are reported when reloading, by compiling the source in the shared Lua state
+		precompiled_bytecode = LuaScriptBytecodeCache::compile(source_code_utf8, path);
+		if (use_cache && !precompiled_bytecode.is_empty()) {
+			LuaScriptBytecodeCache::save(path, source_hash, precompiled_bytecode);
+		}
 	}
-	else if (LuaTable *table = Object::cast_to<LuaTable>(result)) {
-		placeholder_fallback_enabled = false;
-		metadata.clear();
-		metadata.setup(table->get_table());
+
+	if (analysis_task >= 0) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(analysis_task);
 	}
-	return OK;
 }
 
 StringName LuaScript::_get_doc_class_name() const {
@@ -305,7 +387,13 @@ Variant LuaScript::_new(const Variant **args, GDExtensionInt arg_count, GDExtens
 		return {};
 	}
 
-	Variant new_instance = ClassDB::instantiate(_get_instance_base_type());
+	Variant new_instance = _pop_pooled_instance();
+	if (Object *obj = new_instance) {
+		_internal_instance_init(obj, args, arg_count);
+		return new_instance;
+	}
+
+	new_instance = ClassDB::instantiate(_get_instance_base_type());
 	if (Object *obj = new_instance) {
 		GDExtensionScriptInstancePtr script_instance = _internal_instance_create(obj, args, arg_count);
 		ERR_FAIL_COND_V(script_instance == nullptr, Variant());
@@ -313,6 +401,76 @@ Variant LuaScript::_new(const Variant **args, GDExtensionInt arg_count, GDExtens
 	return new_instance;
 }
 
+Array LuaScript::new_batch(int count, const Array& init_args) {
+	Array objects;
+	ERR_FAIL_COND_V_MSG(count < 0, objects, "Instance count must not be negative.");
+	ERR_FAIL_COND_V_MSG(!_can_instantiate(), objects, String("Cannot instantiate script '%s'.") % get_path());
+	objects.resize(count);
+
+	StringName base_type = _get_instance_base_type();
+	for (int i = 0; i < count; i++) {
+		Variant new_instance = _pop_pooled_instance();
+		if (new_instance.get_type() == Variant::NIL) {
+			new_instance = ClassDB::instantiate(base_type);
+			Object *obj = new_instance;
+			ERR_FAIL_NULL_V_MSG(obj, objects, String("Could not instantiate base class '%s'.") % base_type);
+			_internal_instance_attach(obj);
+		}
+		objects[i] = new_instance;
+	}
+
+	// `_init` is looked up and its arguments are prepared only once.
+	// It runs in a coroutine just like in `new`, so it may `await`, but all objects share the same coroutine until one of them does.
+	if (const LuaScriptMethod *_init = metadata.methods.getptr(string_names->_init)) {
+		LuaCoroutine::invoke_lua_batch(_init->method, objects, init_args);
+	}
+	return objects;
+}
+
+bool LuaScript::recycle(Object *object) {
+	ERR_FAIL_NULL_V(object, false);
+	ERR_FAIL_COND_V_MSG(!_instance_has(object), false, String("Object %s is not an instance of script '%s'.") % Array::make(object, get_path()));
+	LuaScriptInstance *instance = LuaScriptInstance::attached_to_object(object);
+	ERR_FAIL_COND_V_MSG(instance && instance->is_pooled, false, String("Object %s is already in the instance pool.") % object);
+	if (instance_pool.size() >= instance_pool_size) {
+		return false;
+	}
+
+	if (Node *node = Object::cast_to<Node>(object)) {
+		if (Node *parent = node->get_parent()) {
+			parent->remove_child(node);
+		}
+	}
+	if (instance) {
+		instance->is_pooled = true;
+	}
+	instance_pool.append(object);
+	return true;
+}
+
+int LuaScript::get_instance_pool_size() const {
+	return instance_pool_size;
+}
+
+void LuaScript::set_instance_pool_size(int size) {
+	instance_pool_size = MAX(size, 0);
+	_trim_instance_pool(instance_pool_size);
+}
+
+void LuaScript::clear_instance_pools() {
+	// Pooled instances reference their script back, so scripts with pooled instances are never freed on their own.
+	// Scripts are referenced while clearing, since freeing the last pooled instance may free its script.
+	LocalVector<Ref<LuaScript>> scripts;
+	for (auto [script, _] : placeholders) {
+		if (!script->instance_pool.is_empty()) {
+			scripts.push_back(Ref<LuaScript>(const_cast<LuaScript *>(script)));
+		}
+	}
+	for (const Ref<LuaScript>& script : scripts) {
+		script->_trim_instance_pool(0);
+	}
+}
+
 const LuaScriptMetadata& LuaScript::get_metadata() const {
 	return metadata;
 }
@@ -325,8 +483,41 @@ void LuaScript::set_import_behavior(ImportBehavior import_behavior) {
 	LuaScriptImportBehaviorManager::get_singleton()->set_script_import_behavior(get_path(), import_behavior);
 }
 
+bool LuaScript::should_evaluate() const {
+	switch (get_import_behavior()) {
+		case IMPORT_BEHAVIOR_AUTOMATIC:
+			return get_looks_like_godot_script();
+
+		case IMPORT_BEHAVIOR_DONT_LOAD:
+			return false;
+
+		default:
+			return true;
+	}
+}
+
+bool LuaScript::should_evaluate_file(const String& path, const String& source_code) {
+	switch (LuaScriptImportBehaviorManager::get_singleton()->get_script_import_behavior(path)) {
+		case IMPORT_BEHAVIOR_AUTOMATIC:
+			return _analyze_source(LuaScriptLanguage::get_singleton()->get_lua_parser(), path, source_code);
+
+		case IMPORT_BEHAVIOR_DONT_LOAD:
+			return false;
+
+		default:
+			return true;
+	}
+}
+
 bool LuaScript::get_looks_like_godot_script() const {
-	Ref<LuaAST> ast = LuaScriptLanguage::get_singleton()->get_lua_parser()->parse_code(source_code);
+	if (analyzed_looks_like_godot_script >= 0) {
+		return analyzed_looks_like_godot_script;
+	}
+	return _analyze_source(LuaScriptLanguage::get_singleton()->get_lua_parser());
+}
+
+bool LuaScript::_looks_like_godot_script(LuaParser *parser, const String& source_code) {
+	Ref<LuaAST> ast = parser->parse_code(source_code);
 	if (ast.is_null()) {
 		return false;
 	}
@@ -336,17 +527,48 @@ bool LuaScript::get_looks_like_godot_script() const {
 	return query->first_match() != Variant();
 }
 
+bool LuaScript::_analyze_source(LuaParser *parser) const {
+	bool result = _analyze_source(parser, get_path(), source_code);
+	analyzed_looks_like_godot_script = result;
+	return result;
+}
+
+bool LuaScript::_analyze_source(LuaParser *parser, const String& path, const String& source_code) {
+	LuaScriptImportBehaviorManager *manager = LuaScriptImportBehaviorManager::get_singleton();
+	String source_hash = source_code.md5_text();
+	int cached_result = manager->get_looks_like_godot_script(path, source_hash);
+	if (cached_result >= 0) {
+		return cached_result;
+	}
+
+	bool result = _looks_like_godot_script(parser, source_code);
+	manager->set_looks_like_godot_script(path, source_hash, result);
+	return result;
+}
+
+void LuaScript::_analyze_source_in_thread() {
+	// The language's parser is not thread-safe, so use a throwaway one
+	Ref<LuaParser> parser;
+	parser.instantiate();
+	_analyze_source(parser.ptr());
+}
+
 void LuaScript::_bind_methods() {
 	BIND_ENUM_CONSTANT(IMPORT_BEHAVIOR_AUTOMATIC);
 	BIND_ENUM_CONSTANT(IMPORT_BEHAVIOR_ALWAYS_EVALUATE);
 	BIND_ENUM_CONSTANT(IMPORT_BEHAVIOR_DONT_LOAD);
 
 	ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, string_names->_new, &LuaScript::_new);
+	ClassDB::bind_method(D_METHOD("new_batch", "count", "init_args"), &LuaScript::new_batch, DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("recycle", "object"), &LuaScript::recycle);
+	ClassDB::bind_method(D_METHOD("set_instance_pool_size", "size"), &LuaScript::set_instance_pool_size);
+	ClassDB::bind_method(D_METHOD("get_instance_pool_size"), &LuaScript::get_instance_pool_size);
 	ClassDB::bind_method(D_METHOD("set_import_behavior", "import_behavior"), &LuaScript::set_import_behavior);
 	ClassDB::bind_method(D_METHOD("get_import_behavior"), &LuaScript::get_import_behavior);
 	ClassDB::bind_method(D_METHOD("get_looks_like_godot_script"), &LuaScript::get_looks_like_godot_script);
 	ADD_PROPERTY(PropertyInfo(Variant::Type::INT, "import_behavior", PROPERTY_HINT_ENUM, "Automatic,Always Evaluate,Don't Load", PROPERTY_USAGE_EDITOR), "set_import_behavior", "get_import_behavior");
 	ADD_PROPERTY(PropertyInfo(Variant::Type::BOOL, "looks_like_godot_script", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_EDITOR | PROPERTY_USAGE_READ_ONLY), "", "get_looks_like_godot_script");
+	ADD_PROPERTY(PropertyInfo(Variant::Type::INT, "instance_pool_size", PROPERTY_HINT_RANGE, "0,1000000,1,or_greater", PROPERTY_USAGE_NONE), "set_instance_pool_size", "get_instance_pool_size");
 }
 
 String LuaScript::_to_string() const {
@@ -364,13 +586,132 @@ void LuaScript::_update_placeholder_exports(void *placeholder) const {
 }
 
 GDExtensionScriptInstancePtr LuaScript::_internal_instance_create(Object *for_object, const Variant **args, GDExtensionInt arg_count) const {
+	GDExtensionScriptInstancePtr gd_script_instance = _internal_instance_attach(for_object);
+	_internal_instance_init(for_object, args, arg_count);
+	return gd_script_instance;
+}
+
+GDExtensionScriptInstancePtr LuaScript::_internal_instance_attach(Object *for_object) const {
 	LuaScriptInstance *lua_script_instance = memnew(LuaScriptInstance(for_object, Ref<LuaScript>(this)));
 	GDExtensionScriptInstancePtr gd_script_instance = gdextension_interface::script_instance_create3(LuaScriptInstance::get_script_instance_info(), lua_script_instance);
 	gdextension_interface::object_set_script_instance(for_object->_owner, gd_script_instance);
+	return gd_script_instance;
+}
+
+void LuaScript::_internal_instance_init(Object *for_object, const Variant **args, GDExtensionInt arg_count) const {
 	if (const LuaScriptMethod *_init = metadata.methods.getptr(string_names->_init)) {
 		LuaCoroutine::invoke_lua(_init->method, VariantArguments(for_object, args, arg_count), false);
 	}
-	return gd_script_instance;
+}
+
+void LuaScript::_set_base_script(const String& path) {
+	Ref<LuaScript> new_base_script;
+	if (!path.is_empty()) {
+		String full_path = path.is_relative_path() ? get_path().get_base_dir().path_join(path) : path;
+		new_base_script = ResourceLoader::get_singleton()->load(full_path);
+		if (new_base_script.is_null()) {
+			ERR_PRINT(String("Could not load base script '%s' for script '%s'.") % Array::make(full_path, get_path()));
+		}
+		else if (new_base_script->_inherits_script(this)) {
+			ERR_PRINT(String("Cyclic inheritance between scripts '%s' and '%s'.") % Array::make(full_path, get_path()));
+			new_base_script.unref();
+		}
+	}
+
+	if (base_script.is_valid()) {
+		base_script->inheriting_scripts.erase(this);
+	}
+	base_script = new_base_script;
+	if (base_script.is_valid()) {
+		base_script->inheriting_scripts.insert(this);
+	}
+}
+
+void LuaScript::_update_metadata() {
+	metadata = own_metadata;
+	if (base_script.is_valid()) {
+		metadata.inherit(base_script->metadata);
+	}
+	// Scripts that extend this one need to be flattened again
+	for (LuaScript *script : inheriting_scripts) {
+		script->_update_metadata();
+	}
+}
+
+Variant LuaScript::_pop_pooled_instance() {
+	while (!instance_pool.is_empty()) {
+		Variant pooled_instance = instance_pool.pop_back();
+		if (!UtilityFunctions::is_instance_valid(pooled_instance)) {
+			continue;
+		}
+		LuaScriptInstance *instance = LuaScriptInstance::attached_to_object(pooled_instance);
+		if (instance && instance->script.ptr() == this) {
+			instance->is_pooled = false;
+			instance->clear_variables();
+			return pooled_instance;
+		}
+	}
+	return Variant();
+}
+
+void LuaScript::_trim_instance_pool(int size) {
+	while (instance_pool.size() > size) {
+		Variant pooled_instance = instance_pool.pop_back();
+		if (!UtilityFunctions::is_instance_valid(pooled_instance)) {
+			continue;
+		}
+		if (LuaScriptInstance *instance = LuaScriptInstance::attached_to_object(pooled_instance)) {
+			instance->is_pooled = false;
+		}
+		// Non-RefCounted objects are owned by the pool while they are inside it
+		if (!Object::cast_to<RefCounted>(pooled_instance)) {
+			memdelete((Object *) pooled_instance);
+		}
+	}
+}
+
+Variant LuaScript::_load_source(const PackedByteArray& source_utf8, const PackedByteArray& precompiled_bytecode) const {
+	LuaState *lua_state = LuaScriptLanguage::get_singleton()->get_lua_state();
+	String path = get_path();
+	if (LuaScriptBytecodeArchive *archive = LuaScriptBytecodeArchive::get_singleton(); archive && archive->has_file(path)) {
+		Variant result = lua_state->load_buffer(archive->get_bytecode(path), path, LuaState::LOAD_MODE_BINARY);
+		if (Object::cast_to<LuaFunction>(result) || source_utf8.is_empty()) {
+			return result;
+		}
+	}
+
+	if (!precompiled_bytecode.is_empty()) {
+		Variant result = lua_state->load_buffer(precompiled_bytecode, path, LuaState::LOAD_MODE_BINARY);
+		if (Object::cast_to<LuaFunction>(result) || source_utf8.is_empty()) {
+			return result;
+		}
+	}
+
+	bool use_cache = !path.is_empty() && LuaScriptBytecodeCache::is_enabled();
+
+	PackedByteArray source_hash;
+	if (use_cache) {
+		source_hash = LuaScriptBytecodeCache::hash_source(source_utf8);
+		PackedByteArray bytecode = LuaScriptBytecodeCache::load(path, source_hash);
+		if (!bytecode.is_empty()) {
+			Variant result = lua_state->load_buffer(bytecode, path, LuaState::LOAD_MODE_BINARY);
+			if (Object::cast_to<LuaFunction>(result)) {
+				return result;
+			}
+			// Invalid cache entries are overwritten below
+		}
+	}
+
+	Variant result = lua_state->load_buffer(source_utf8, path, LuaState::LOAD_MODE_TEXT);
+	if (use_cache) {
+		if (LuaFunction *function = Object::cast_to<LuaFunction>(result)) {
+			PackedByteArray bytecode = LuaFunction::dump(function->get_function(), false);
+			if (!bytecode.is_empty()) {
+				LuaScriptBytecodeCache::save(path, source_hash, bytecode);
+			}
+		}
+	}
+	return result;
 }
 
 HashMap<const LuaScript *, HashSet<void *>> LuaScript::placeholders;
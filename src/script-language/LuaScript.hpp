@@ -33,6 +33,7 @@ using namespace godot;
 namespace luagdextension {
 
 class LuaFunction;
+class LuaParser;
 class LuaScriptInstance;
 class LuaScriptLanguage;
 class LuaTable;
@@ -90,11 +91,27 @@ public:
 
 	// Script methods
 	Variant _new(const Variant **args, GDExtensionInt arg_count, GDExtensionCallError &error);
+	Array new_batch(int count, const Array& init_args = Array());
+	bool recycle(Object *object);
 	const LuaScriptMetadata& get_metadata() const;
+	// Set source code from UTF-8 bytes without reloading, avoiding a conversion roundtrip on the next reload
+	void set_source_code_utf8(const PackedByteArray& source_utf8);
+
+	int get_instance_pool_size() const;
+	void set_instance_pool_size(int size);
+	// Free the instances pooled by all scripts, breaking their reference cycle with the script
+	static void clear_instance_pools();
 
 	ImportBehavior get_import_behavior() const;
 	void set_import_behavior(ImportBehavior import_behavior);
 	bool get_looks_like_godot_script() const;
+	// Whether loading this script should evaluate it, based on its import behavior
+	bool should_evaluate() const;
+	// Same as `should_evaluate`, but for a script that was not loaded, without running it
+	static bool should_evaluate_file(const String& path, const String& source_code);
+	// Compile source code and analyze it without touching the shared Lua state, so that it can run in any thread.
+	// The results are consumed by the next reload.
+	void precompile(bool use_sub_threads);
 
 protected:
 	static void _bind_methods();
@@ -103,14 +120,39 @@ protected:
 	void _update_placeholder_exports(void *placeholder) const;
 
 	String source_code;
+	// UTF-8 bytes set by the loader, consumed by the next reload
+	PackedByteArray source_code_utf8;
+	// Bytecode compiled by `precompile`, consumed by the next reload
+	PackedByteArray precompiled_bytecode;
+	// Result of `_analyze_source`, or -1 if source was not analyzed
+	mutable int8_t analyzed_looks_like_godot_script;
+	// Metadata defined by this script's code only
+	LuaScriptMetadata own_metadata;
+	// Own metadata flattened with the base script's, used for all lookups
 	LuaScriptMetadata metadata;
+	Ref<LuaScript> base_script;
+	HashSet<LuaScript *> inheriting_scripts;
 	bool placeholder_fallback_enabled;
+	// Recycled instances, reused by `new` and `new_batch`
+	Array instance_pool;
+	int instance_pool_size;
 
 	// TODO: use instance member instead of static map if "_placeholder_instance_create" is changed to be non-const
 	static HashMap<const LuaScript *, HashSet<void *>> placeholders;
 
 private:
 	GDExtensionScriptInstancePtr _internal_instance_create(Object *for_object, const Variant **args, GDExtensionInt arg_count) const;
+	GDExtensionScriptInstancePtr _internal_instance_attach(Object *for_object) const;
+	void _internal_instance_init(Object *for_object, const Variant **args, GDExtensionInt arg_count) const;
+	Variant _pop_pooled_instance();
+	void _trim_instance_pool(int size);
+	Variant _load_source(const PackedByteArray& source_utf8, const PackedByteArray& precompiled_bytecode) const;
+	bool _analyze_source(LuaParser *parser) const;
+	static bool _analyze_source(LuaParser *parser, const String& path, const String& source_code);
+	void _analyze_source_in_thread();
+	static bool _looks_like_godot_script(LuaParser *parser, const String& source_code);
+	void _set_base_script(const String& path);
+	void _update_metadata();
 };
 
 }
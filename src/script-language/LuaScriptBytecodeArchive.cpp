@@ -0,0 +1,147 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaScriptBytecodeArchive.hpp"
+
+#include "LuaScriptBytecodeCache.hpp"
+
+#include <godot_cpp/classes/stream_peer_buffer.hpp>
+
+namespace luagdextension {
+
+// "LGBA" in little endian
+constexpr uint32_t ARCHIVE_MAGIC = 0x4142474c;
+// Bump whenever the archive file layout changes
+constexpr uint32_t ARCHIVE_FORMAT_VERSION = 1;
+
+enum EntryFlags {
+	ENTRY_FLAG_SCRIPT = 1 << 0,
+};
+
+LuaScriptBytecodeArchive::LuaScriptBytecodeArchive()
+	: data_offset(0)
+	, compression_mode(-1)
+{
+	if (!FileAccess::file_exists(LUA_BYTECODE_ARCHIVE_PATH)) {
+		return;
+	}
+
+	file = FileAccess::open(LUA_BYTECODE_ARCHIVE_PATH, FileAccess::READ);
+	ERR_FAIL_COND_MSG(file.is_null(), "Cannot open Lua bytecode archive");
+	if (file->get_32() != ARCHIVE_MAGIC || file->get_32() != ARCHIVE_FORMAT_VERSION) {
+		file.unref();
+		ERR_FAIL_MSG("Invalid Lua bytecode archive, falling back to Lua source files");
+	}
+	String runtime_id = file->get_pascal_string();
+	if (runtime_id != LuaScriptBytecodeCache::get_runtime_id()) {
+		file.unref();
+		ERR_FAIL_MSG(String("Lua bytecode archive was compiled for '%s', but the current runtime is '%s'. Falling back to Lua source files") % Array::make(runtime_id, LuaScriptBytecodeCache::get_runtime_id()));
+	}
+
+	compression_mode = (int32_t) file->get_32();
+	uint32_t entry_count = file->get_32();
+	entries.reserve(entry_count);
+	for (uint32_t i = 0; i < entry_count; i++) {
+		String path = file->get_pascal_string();
+		Entry entry;
+		entry.is_script = file->get_8() & ENTRY_FLAG_SCRIPT;
+		entry.offset = file->get_64();
+		entry.size = file->get_32();
+		entry.uncompressed_size = file->get_32();
+		entries.insert(path, entry);
+	}
+	data_offset = file->get_position();
+}
+
+bool LuaScriptBytecodeArchive::has_file(const String& path) const {
+	return entries.has(path);
+}
+
+bool LuaScriptBytecodeArchive::is_script(const String& path) const {
+	const Entry *entry = entries.getptr(path);
+	return entry && entry->is_script;
+}
+
+PackedByteArray LuaScriptBytecodeArchive::get_bytecode(const String& path) const {
+	const Entry *entry = entries.getptr(path);
+	if (!entry) {
+		return PackedByteArray();
+	}
+
+	PackedByteArray bytes;
+	{
+		MutexLock lock(file_mutex);
+		file->seek(data_offset + entry->offset);
+		bytes = file->get_buffer(entry->size);
+	}
+	if (compression_mode >= 0) {
+		bytes = bytes.decompress(entry->uncompressed_size, compression_mode);
+	}
+	return bytes;
+}
+
+PackedByteArray LuaScriptBytecodeArchive::pack(const Vector<File>& files, int compression_mode) {
+	Ref<StreamPeerBuffer> index;
+	index.instantiate();
+	index->put_u32(ARCHIVE_MAGIC);
+	index->put_u32(ARCHIVE_FORMAT_VERSION);
+	// StreamPeer UTF-8 strings have the same layout as FileAccess pascal strings
+	index->put_utf8_string(LuaScriptBytecodeCache::get_runtime_id());
+	index->put_32(compression_mode);
+	index->put_u32(files.size());
+
+	PackedByteArray data;
+	for (const File& file : files) {
+		PackedByteArray bytes = compression_mode >= 0 ? file.bytecode.compress(compression_mode) : file.bytecode;
+		index->put_utf8_string(file.path);
+		index->put_u8(file.is_script ? ENTRY_FLAG_SCRIPT : 0);
+		index->put_u64(data.size());
+		index->put_u32(bytes.size());
+		index->put_u32(file.bytecode.size());
+		data.append_array(bytes);
+	}
+
+	PackedByteArray archive = index->get_data_array();
+	archive.append_array(data);
+	return archive;
+}
+
+LuaScriptBytecodeArchive *LuaScriptBytecodeArchive::get_singleton() {
+	return instance;
+}
+
+LuaScriptBytecodeArchive *LuaScriptBytecodeArchive::get_or_create_singleton() {
+	if (instance == nullptr) {
+		instance = memnew(LuaScriptBytecodeArchive);
+	}
+	return instance;
+}
+
+void LuaScriptBytecodeArchive::delete_singleton() {
+	if (instance) {
+		memdelete(instance);
+		instance = nullptr;
+	}
+}
+
+LuaScriptBytecodeArchive *LuaScriptBytecodeArchive::instance;
+
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_SCRIPT_BYTECODE_ARCHIVE_HPP__
+#define __LUA_SCRIPT_BYTECODE_ARCHIVE_HPP__
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/core/mutex.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/vector.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+constexpr char LUA_BYTECODE_ARCHIVE_PATH[] = "res://.godot/lua_gdextension/bytecode.archive";
+
+/**
+ * Single indexed file with precompiled Lua chunks, written by the export plugin.
+ *
+ * Exported projects resolve scripts and `require`d modules from this archive before
+ * falling back to source files, so that only one file needs to be opened on startup.
+ */
+class LuaScriptBytecodeArchive {
+public:
+	struct File {
+		String path;
+		PackedByteArray bytecode;
+		bool is_script;
+	};
+
+	LuaScriptBytecodeArchive();
+
+	bool has_file(const String& path) const;
+	bool is_script(const String& path) const;
+	PackedByteArray get_bytecode(const String& path) const;
+
+	static PackedByteArray pack(const Vector<File>& files, int compression_mode = -1);
+
+	static LuaScriptBytecodeArchive *get_singleton();
+	static LuaScriptBytecodeArchive *get_or_create_singleton();
+	static void delete_singleton();
+
+private:
+	struct Entry {
+		uint64_t offset;
+		uint32_t size;
+		uint32_t uncompressed_size;
+		bool is_script;
+	};
+
+	static LuaScriptBytecodeArchive *instance;
+
+	Ref<FileAccess> file;
+	HashMap<String, Entry> entries;
+	uint64_t data_offset;
+	int compression_mode;
+	mutable Mutex file_mutex;
+};
+
+}
+
+#endif  // __LUA_SCRIPT_BYTECODE_ARCHIVE_HPP__
@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaScriptBytecodeCache.hpp"
+
+#include "../LuaFunction.hpp"
+#include "../LuaState.hpp"
+#include "../utils/convert_godot_std.hpp"
+#include "../utils/project_settings.hpp"
+
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/hashing_context.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+
+namespace luagdextension {
+
+// "LGBC" in little endian
+constexpr uint32_t CACHE_MAGIC = 0x4342474c;
+// Bump whenever the cache file layout changes
+constexpr uint32_t CACHE_FORMAT_VERSION = 1;
+
+bool LuaScriptBytecodeCache::is_enabled() {
+	// Cache files live in the project data directory, which is only available when running from the editor
+	return OS::get_singleton()->has_feature("editor")
+		&& (bool) ProjectSettings::get_singleton()->get_setting_with_override(LUA_SCRIPT_BYTECODE_CACHE_SETTING);
+}
+
+PackedByteArray LuaScriptBytecodeCache::hash_source(const PackedByteArray& source) {
+	Ref<HashingContext> context;
+	context.instantiate();
+	context->start(HashingContext::HASH_SHA256);
+	context->update(source);
+	return context->finish();
+}
+
+PackedByteArray LuaScriptBytecodeCache::load(const String& script_path, const PackedByteArray& source_hash) {
+	Ref<FileAccess> file = FileAccess::open(get_cache_path(script_path), FileAccess::READ);
+	if (file.is_null()) {
+		return PackedByteArray();
+	}
+
+	if (file->get_32() != CACHE_MAGIC
+		|| file->get_32() != CACHE_FORMAT_VERSION
+		|| file->get_pascal_string() != get_runtime_id()
+		|| file->get_buffer(source_hash.size()) != source_hash)
+	{
+		return PackedByteArray();
+	}
+	return file->get_buffer(file->get_length() - file->get_position());
+}
+
+void LuaScriptBytecodeCache::save(const String& script_path, const PackedByteArray& source_hash, const PackedByteArray& bytecode) {
+	String cache_path = get_cache_path(script_path);
+	Error err = DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	ERR_FAIL_COND_MSG(err != OK, "Cannot create Lua bytecode cache directory '" + cache_path.get_base_dir() + "'");
+
+	Ref<FileAccess> file = FileAccess::open(cache_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(file.is_null(), "Cannot write Lua bytecode cache file '" + cache_path + "'");
+	file->store_32(CACHE_MAGIC);
+	file->store_32(CACHE_FORMAT_VERSION);
+	file->store_pascal_string(get_runtime_id());
+	file->store_buffer(source_hash);
+	file->store_buffer(bytecode);
+}
+
+PackedByteArray LuaScriptBytecodeCache::compile(const PackedByteArray& source, const String& chunkname, bool strip, String *r_error) {
+	// No libraries needed, the state is used only for compiling
+	sol::state compiler;
+	sol::load_result result = compiler.load(to_string_view(source), to_std_string(chunkname), sol::load_mode::text);
+	if (!result.valid()) {
+		if (r_error) {
+			sol::error error = result;
+			*r_error = error.what();
+		}
+		return PackedByteArray();
+	}
+	return LuaFunction::dump(result.get<sol::protected_function>(), strip);
+}
+
+String LuaScriptBytecodeCache::get_runtime_id() {
+	// Bytecode is not portable between runtimes or versions
+#ifdef LUAJIT
+	// LuaJIT bytecode also depends on the pointer size (GC64 mode)
+	return String("%s %s %d") % Array::make(LuaState::get_lua_runtime(), LuaState::get_lua_version_string(), (int) sizeof(void *) * 8);
+#else
+	return LuaState::get_lua_runtime() + " " + LuaState::get_lua_version_string();
+#endif
+}
+
+String LuaScriptBytecodeCache::get_cache_path(const String& script_path) {
+	bool use_hidden_data_dir = ProjectSettings::get_singleton()->get_setting("application/config/use_hidden_project_data_directory", true);
+	return String(use_hidden_data_dir ? "res://.godot" : "res://godot")
+		.path_join("lua_gdextension/bytecode")
+		.path_join(script_path.md5_text() + ".luac");
+}
+
+}
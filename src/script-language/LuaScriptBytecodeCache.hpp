@@ -0,0 +1,55 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_SCRIPT_BYTECODE_CACHE_HPP__
+#define __LUA_SCRIPT_BYTECODE_CACHE_HPP__
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Persistent cache of compiled Lua script chunks, stored in the project data directory.
+ *
+ * Entries are keyed by the script path and validated against the source hash and Lua runtime,
+ * so callers should always be ready to fallback to loading the source code.
+ */
+class LuaScriptBytecodeCache {
+public:
+	static bool is_enabled();
+
+	static PackedByteArray hash_source(const PackedByteArray& source);
+	static PackedByteArray load(const String& script_path, const PackedByteArray& source_hash);
+	static void save(const String& script_path, const PackedByteArray& source_hash, const PackedByteArray& bytecode);
+
+	// Compile in a throwaway Lua state, so it's safe to call from any thread.
+	// Returns an empty array on errors.
+	static PackedByteArray compile(const PackedByteArray& source, const String& chunkname, bool strip = false, String *r_error = nullptr);
+	static String get_runtime_id();
+	static String get_cache_path(const String& script_path);
+};
+
+}
+
+#endif  // __LUA_SCRIPT_BYTECODE_CACHE_HPP__
@@ -0,0 +1,195 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifdef DEBUG_ENABLED
+
+#include "LuaScriptExportPlugin.hpp"
+
+#include "LuaScript.hpp"
+#include "LuaScriptBytecodeArchive.hpp"
+#include "LuaScriptBytecodeCache.hpp"
+#include "../utils/module_resolution_cache.hpp"
+
+#include <godot_cpp/classes/editor_export_preset.hpp>
+#include <godot_cpp/classes/editor_file_system.hpp>
+#include <godot_cpp/classes/editor_interface.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+
+namespace luagdextension {
+
+constexpr char PRECOMPILE_OPTION[] = "lua_gdextension/precompile_lua_files";
+constexpr char COMPRESSION_OPTION[] = "lua_gdextension/bytecode_compression";
+constexpr char STRIP_DEBUG_INFO_OPTION[] = "lua_gdextension/strip_debug_info";
+constexpr char MODULE_INDEX_OPTION[] = "lua_gdextension/module_index";
+
+static Dictionary export_option(const String& name, Variant::Type type, const Variant& default_value, PropertyHint hint = PROPERTY_HINT_NONE, const String& hint_string = "") {
+	Dictionary option;
+	option["name"] = name;
+	option["type"] = type;
+	option["hint"] = hint;
+	option["hint_string"] = hint_string;
+
+	Dictionary export_option;
+	export_option["option"] = option;
+	export_option["default_value"] = default_value;
+	return export_option;
+}
+
+String LuaScriptExportPlugin::_get_name() const {
+	return "LuaGDExtension";
+}
+
+TypedArray<Dictionary> LuaScriptExportPlugin::_get_export_options(const Ref<EditorExportPlatform>& platform) const {
+	TypedArray<Dictionary> options;
+	options.append(export_option(PRECOMPILE_OPTION, Variant::BOOL, true));
+	// Values are FileAccess::CompressionMode + 1, so that 0 means no compression
+	options.append(export_option(COMPRESSION_OPTION, Variant::INT, 0, PROPERTY_HINT_ENUM, "None,FastLZ,Deflate,Zstd,GZip"));
+	options.append(export_option(STRIP_DEBUG_INFO_OPTION, Variant::BOOL, false));
+	options.append(export_option(MODULE_INDEX_OPTION, Variant::BOOL, true));
+	return options;
+}
+
+void LuaScriptExportPlugin::_export_begin(const PackedStringArray& features, bool is_debug, const String& path, uint32_t flags) {
+	archived_files.clear();
+
+	// Files added after `_export_begin` are ignored by the exporter,
+	// so the whole archive and module index must be built upfront
+	PackedStringArray lua_files;
+	_collect_lua_files(EditorInterface::get_singleton()->get_resource_filesystem()->get_filesystem(), lua_files);
+	PackedStringArray exported_lua_files;
+	for (const String& lua_file : lua_files) {
+		if (_is_exported(lua_file)) {
+			exported_lua_files.append(lua_file);
+		}
+	}
+
+	// When exporting selected files, Lua modules may still be exported as dependencies and the index would miss them
+	EditorExportPreset::ExportFilter export_filter = get_export_preset()->get_export_filter();
+	bool knows_exported_files = export_filter == EditorExportPreset::EXPORT_ALL_RESOURCES || export_filter == EditorExportPreset::EXCLUDE_SELECTED_RESOURCES;
+	if (get_option(MODULE_INDEX_OPTION) && knows_exported_files) {
+		add_file(LUA_MODULE_INDEX_PATH, build_module_index(exported_lua_files), false);
+	}
+
+	if (!get_option(PRECOMPILE_OPTION)) {
+		return;
+	}
+	if (!_can_precompile_for(features)) {
+		WARN_PRINT("Target platform uses a different Lua runtime than the editor, Lua files will be exported as source code");
+		return;
+	}
+
+	bool strip = get_option(STRIP_DEBUG_INFO_OPTION);
+	Vector<LuaScriptBytecodeArchive::File> files;
+	for (const String& lua_file : exported_lua_files) {
+		String error;
+		PackedByteArray source_utf8 = FileAccess::get_file_as_bytes(lua_file);
+		PackedByteArray bytecode = LuaScriptBytecodeCache::compile(source_utf8, lua_file, strip, &error);
+		if (bytecode.is_empty()) {
+			WARN_PRINT(String("Cannot precompile '%s', exporting it as source code: %s") % Array::make(lua_file, error));
+			continue;
+		}
+
+		LuaScriptBytecodeArchive::File file;
+		file.path = lua_file;
+		file.bytecode = bytecode;
+		// Analyze sources instead of loading them, since loading scripts runs their code
+		file.is_script = LuaScript::should_evaluate_file(lua_file, source_utf8.get_string_from_utf8());
+		files.push_back(file);
+		archived_files.insert(lua_file);
+	}
+
+	if (!files.is_empty()) {
+		int compression_mode = (int) get_option(COMPRESSION_OPTION) - 1;
+		add_file(LUA_BYTECODE_ARCHIVE_PATH, LuaScriptBytecodeArchive::pack(files, compression_mode), false);
+	}
+}
+
+void LuaScriptExportPlugin::_export_file(const String& path, const String& type, const PackedStringArray& features) {
+	if (archived_files.has(path)) {
+		skip();
+	}
+}
+
+void LuaScriptExportPlugin::_export_end() {
+	archived_files.clear();
+}
+
+bool LuaScriptExportPlugin::_can_precompile_for(const PackedStringArray& features) const {
+#ifdef LUAJIT
+	// Web builds use Lua 5.4, since LuaJIT does not support WebAssembly
+	if (features.has("web")) {
+		return false;
+	}
+	// LuaJIT bytecode depends on the pointer size (GC64 mode)
+	bool target_is_32_bits = features.has("x86_32") || features.has("arm32");
+	return target_is_32_bits == (sizeof(void *) == 4);
+#else
+	return true;
+#endif
+}
+
+bool LuaScriptExportPlugin::_is_exported(const String& path) const {
+	Ref<EditorExportPreset> preset = get_export_preset();
+	switch (preset->get_export_filter()) {
+		case EditorExportPreset::EXPORT_ALL_RESOURCES:
+			break;
+
+		case EditorExportPreset::EXCLUDE_SELECTED_RESOURCES:
+			if (preset->has_export_file(path)) {
+				return false;
+			}
+			break;
+
+		default:
+			// Files not explicitly selected are still exported as source code, if needed
+			if (!preset->has_export_file(path)) {
+				return false;
+			}
+			break;
+	}
+
+	for (const String& filter : preset->get_exclude_filter().split(",", false)) {
+		String pattern = filter.strip_edges();
+		if (path.matchn(pattern) || path.trim_prefix("res://").matchn(pattern)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void LuaScriptExportPlugin::_collect_lua_files(EditorFileSystemDirectory *dir, PackedStringArray& files) const {
+	for (int i = 0; i < dir->get_file_count(); i++) {
+		String file_path = dir->get_file_path(i);
+		if (file_path.get_extension() == "lua") {
+			files.append(file_path);
+		}
+	}
+	for (int i = 0; i < dir->get_subdir_count(); i++) {
+		_collect_lua_files(dir->get_subdir(i), files);
+	}
+}
+
+void LuaScriptExportPlugin::_bind_methods() {
+}
+
+}
+
+#endif  // DEBUG_ENABLED
@@ -0,0 +1,65 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_SCRIPT_EXPORT_PLUGIN_HPP__
+#define __LUA_SCRIPT_EXPORT_PLUGIN_HPP__
+
+#ifdef DEBUG_ENABLED
+
+#include <godot_cpp/classes/editor_export_plugin.hpp>
+#include <godot_cpp/classes/editor_file_system_directory.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Precompiles Lua files into a single bytecode archive when exporting projects.
+ *
+ * Archived files have their source skipped from the export, see `LuaScriptBytecodeArchive`.
+ */
+class LuaScriptExportPlugin : public EditorExportPlugin {
+	GDCLASS(LuaScriptExportPlugin, EditorExportPlugin);
+
+public:
+	String _get_name() const override;
+	TypedArray<Dictionary> _get_export_options(const Ref<EditorExportPlatform>& platform) const override;
+	void _export_begin(const PackedStringArray& features, bool is_debug, const String& path, uint32_t flags) override;
+	void _export_file(const String& path, const String& type, const PackedStringArray& features) override;
+	void _export_end() override;
+
+protected:
+	static void _bind_methods();
+
+private:
+	bool _can_precompile_for(const PackedStringArray& features) const;
+	bool _is_exported(const String& path) const;
+	void _collect_lua_files(EditorFileSystemDirectory *dir, PackedStringArray& files) const;
+
+	HashSet<String> archived_files;
+};
+
+}
+
+#endif  // DEBUG_ENABLED
+
+#endif  // __LUA_SCRIPT_EXPORT_PLUGIN_HPP__
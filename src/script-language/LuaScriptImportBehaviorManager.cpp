@@ -23,16 +23,27 @@
 
 #include "../utils/project_settings.hpp"
 
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
 #include <godot_cpp/classes/resource_uid.hpp>
 
 namespace luagdextension {
 
+constexpr char ANALYSIS_CACHE_PATH[] = "res://.godot/lua_gdextension/script_analysis.cache";
+
 LuaScriptImportBehaviorManager::LuaScriptImportBehaviorManager()
 	: map(ProjectSettings::get_singleton()->get_setting_with_override(LUA_SCRIPT_IMPORT_MAP_SETTING))
+	, analysis_cache_dirty(false)
 {
 	prune_non_existent_uids();
+	load_analysis_cache();
+}
+
+LuaScriptImportBehaviorManager::~LuaScriptImportBehaviorManager() {
+	save_analysis_cache();
 }
 
 void LuaScriptImportBehaviorManager::set_script_import_behavior(const String& script_path, int behavior) {
@@ -62,6 +73,31 @@ int LuaScriptImportBehaviorManager::get_script_import_behavior(const String& scr
 	}
 }
 
+int LuaScriptImportBehaviorManager::get_looks_like_godot_script(const String& script_path, const String& source_hash) const {
+	if (script_path.is_empty()) {
+		return -1;
+	}
+
+	MutexLock lock(analysis_cache_mutex);
+	Array entry = analysis_cache.get(script_path, Array());
+	if (entry.size() == 2 && entry[0] == source_hash) {
+		return (bool) entry[1];
+	}
+	else {
+		return -1;
+	}
+}
+
+void LuaScriptImportBehaviorManager::set_looks_like_godot_script(const String& script_path, const String& source_hash, bool looks_like_godot_script) {
+	if (script_path.is_empty()) {
+		return;
+	}
+
+	MutexLock lock(analysis_cache_mutex);
+	analysis_cache[script_path] = Array::make(source_hash, looks_like_godot_script);
+	analysis_cache_dirty = true;
+}
+
 void LuaScriptImportBehaviorManager::prune_non_existent_uids() {
 	Array keys = map.keys();
 	bool should_save = false;
@@ -101,6 +137,42 @@ void LuaScriptImportBehaviorManager::save_map() {
 	ProjectSettings::get_singleton()->save();
 }
 
+void LuaScriptImportBehaviorManager::load_analysis_cache() {
+	// The analysis cache lives in the project data directory, which is only available when running from the editor
+	if (!OS::get_singleton()->has_feature("editor") || !FileAccess::file_exists(ANALYSIS_CACHE_PATH)) {
+		return;
+	}
+
+	Ref<FileAccess> file = FileAccess::open(ANALYSIS_CACHE_PATH, FileAccess::READ);
+	if (file.is_valid()) {
+		Dictionary cache = file->get_var();
+		// Skip entries of scripts that were deleted or moved
+		Array paths = cache.keys();
+		for (int64_t i = 0; i < paths.size(); i++) {
+			String path = paths[i];
+			if (FileAccess::file_exists(path)) {
+				analysis_cache[path] = cache[path];
+			}
+			else {
+				analysis_cache_dirty = true;
+			}
+		}
+	}
+}
+
+void LuaScriptImportBehaviorManager::save_analysis_cache() {
+	MutexLock lock(analysis_cache_mutex);
+	if (!analysis_cache_dirty || !OS::get_singleton()->has_feature("editor")) {
+		return;
+	}
+
+	DirAccess::make_dir_recursive_absolute(String(ANALYSIS_CACHE_PATH).get_base_dir());
+	Ref<FileAccess> file = FileAccess::open(ANALYSIS_CACHE_PATH, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(file.is_null(), String("Cannot write Lua script analysis cache '%s'") % ANALYSIS_CACHE_PATH);
+	file->store_var(analysis_cache);
+	analysis_cache_dirty = false;
+}
+
 LuaScriptImportBehaviorManager *LuaScriptImportBehaviorManager::instance;
 
 }
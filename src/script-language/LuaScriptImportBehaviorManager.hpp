@@ -22,6 +22,7 @@
 #ifndef __LUA_SCRIPT_IMPORT_BEHAVIOR_MANAGER_HPP__
 #define __LUA_SCRIPT_IMPORT_BEHAVIOR_MANAGER_HPP__
 
+#include <godot_cpp/core/mutex.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/string.hpp>
 
@@ -32,10 +33,18 @@ namespace luagdextension {
 class LuaScriptImportBehaviorManager {
 public:
 	LuaScriptImportBehaviorManager();
+	~LuaScriptImportBehaviorManager();
 	
 	void set_script_import_behavior(const String& script_path, int behavior);
 	int get_script_import_behavior(const String& script_path) const;
 
+	// Cached results of `LuaScript.get_looks_like_godot_script`, keyed by script path and source hash.
+	// Returns -1 if there is no result cached for this source.
+	int get_looks_like_godot_script(const String& script_path, const String& source_hash) const;
+	void set_looks_like_godot_script(const String& script_path, const String& source_hash, bool looks_like_godot_script);
+	// Writes pending analysis results to the project data directory, only when running from the editor.
+	void save_analysis_cache();
+
 	void prune_non_existent_uids();
 	
 	static LuaScriptImportBehaviorManager *get_singleton();
@@ -46,8 +55,13 @@ private:
 	static LuaScriptImportBehaviorManager *instance;
 
 	void save_map();
+	void load_analysis_cache();
 	
 	Dictionary map;
+	// Script path -> [source hash, looks like Godot script]
+	Dictionary analysis_cache;
+	bool analysis_cache_dirty;
+	mutable Mutex analysis_cache_mutex;
 };
 
 }
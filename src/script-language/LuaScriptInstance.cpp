@@ -19,6 +19,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/classes/script.hpp>
 
 #include "LuaScriptInstance.hpp"
@@ -30,9 +31,11 @@
 #include "../LuaCoroutine.hpp"
 #include "../LuaError.hpp"
 #include "../LuaFunction.hpp"
+#include "../LuaState.hpp"
 #include "../utils/VariantArguments.hpp"
 #include "../utils/function_wrapper.hpp"
 #include "../utils/method_bind_impl.hpp"
+#include "../utils/stack_top_checker.hpp"
 #include "../utils/string_names.hpp"
 
 namespace luagdextension {
@@ -116,20 +119,56 @@ static void destroy_MethodInfos(const GDExtensionMethodInfo *minfos, uint32_t co
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Address used as a light userdata key that maps instance tables to their LuaScriptInstance
+static char instance_key;
+
 LuaScriptInstance::LuaScriptInstance(Object *owner, Ref<LuaScript> script)
 	: owner(owner)
 	, script(script)
+	, is_pooled(false)
 {
-	owner_to_instance.insert(owner, this);
+	get_instance_binding(owner, true)->instance = this;
+	live_instance_count.fetch_add(1, std::memory_order_relaxed);
+
+	// RefCounted owners are still passed to Lua as Variants: the table cannot
+	// hold a strong reference to its owner without creating a reference cycle
+	is_table_exposed = !Object::cast_to<RefCounted>(owner);
 
 	const LuaScriptMetadata& metadata = script->get_metadata();
-	for (auto [name, signal] : metadata.signals) {
-		data[name] = Signal(owner, name);
-	}
+	lua_State *L = LuaScriptLanguage::get_singleton()->get_lua_state()->get_lua_state();
+	StackTopChecker topcheck(L);
+	// preallocate fields for properties, signals and the instance key
+	lua_createtable(L, 0, metadata.properties.size() + metadata.signals.size() + 1);
+	lua_pushlightuserdata(L, &instance_key);
+	lua_pushlightuserdata(L, this);
+	lua_rawset(L, -3);
+	instance_metatable.push(L);
+	lua_setmetatable(L, -2);
+	table = sol::table(L, -1);
+	lua_pop(L, 1);
+	if (is_table_exposed) {
+		sol::stack::push_userdata(L, Variant(owner));
+		owner_userdata = sol::object(L, -1);
+		lua_pop(L, 1);
+	}
+
+	add_signal_variables();
 }
 
 LuaScriptInstance::~LuaScriptInstance() {
-	owner_to_instance.erase(owner);
+	live_instance_count.fetch_sub(1, std::memory_order_relaxed);
+	if (InstanceBinding *binding = get_instance_binding(owner, false)) {
+		binding->instance = nullptr;
+	}
+
+	// Lua code may still reference the table, make sure it doesn't point to this instance anymore
+	lua_State *L = table.lua_state();
+	StackTopChecker topcheck(L);
+	table.push();
+	lua_pushlightuserdata(L, &instance_key);
+	lua_pushnil(L);
+	lua_rawset(L, -3);
+	lua_pop(L, 1);
 }
 
 GDExtensionBool set_func(LuaScriptInstance *p_instance, const StringName *p_name, const Variant *p_value) {
@@ -154,7 +193,7 @@ GDExtensionBool set_func(LuaScriptInstance *p_instance, const StringName *p_name
 
 	// d) set raw data unless it's metadata
 	if (!p_name->begins_with("metadata/")) {
-		p_instance->data[*p_name] = *p_value;
+		p_instance->set_variable(*p_name, *p_value);
 		return true;
 	}
 	
@@ -178,16 +217,18 @@ GDExtensionBool get_func(LuaScriptInstance *p_instance, const StringName *p_name
 	}
 
 	// c) access raw data
-	if (p_instance->data.has(*p_name)) {
-		*p_value = p_instance->data[*p_name];
+	if (p_instance->get_variable(*p_name, *p_value)) {
 		return true;
 	}
 
 	// d) fallback to default property value, if there is one
 	if (property) {
-		Variant value = property->instantiate_default_value();
-		p_instance->data[*p_name] = value;
-		*p_value = value;
+		*p_value = property->instantiate_default_value();
+		// Shared defaults are not stored, only per-instance copies need to be.
+		// Same as in `instance__index`, so reads from Godot and Lua leave instances in the same state.
+		if (!property->is_default_value_shared()) {
+			p_instance->set_variable(*p_name, *p_value);
+		}
 		return true;
 	}
 
@@ -248,12 +289,30 @@ Object *get_owner_func(LuaScriptInstance *p_instance) {
 	return p_instance->owner;
 }
 
-void get_property_state_func(LuaScriptInstance *p_instance, GDExtensionScriptInstancePropertyStateAdd p_add_func, void *p_userdata) {
-	for (Variant key : p_instance->data.keys()) {
-		StringName name = key;
-		Variant value = p_instance->data[key];
-		p_add_func(&name, &value, p_userdata);
+static void add_property_state(const sol::table& table, GDExtensionScriptInstancePropertyStateAdd p_add_func, void *p_userdata) {
+	if (!table.valid()) {
+		return;
 	}
+
+	lua_State *L = table.lua_state();
+	StackTopChecker topcheck(L);
+	table.push();
+	lua_pushnil(L);
+	while (lua_next(L, -2)) {
+		// skip non-string keys, like the one used to find the LuaScriptInstance
+		if (lua_type(L, -2) == LUA_TSTRING) {
+			StringName name = sol::stack::get<StringName>(L, -2);
+			Variant value = to_variant(L, -1);
+			p_add_func(&name, &value, p_userdata);
+		}
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+}
+
+void get_property_state_func(LuaScriptInstance *p_instance, GDExtensionScriptInstancePropertyStateAdd p_add_func, void *p_userdata) {
+	add_property_state(p_instance->table, p_add_func, p_userdata);
+	add_property_state(p_instance->accessor_table, p_add_func, p_userdata);
 }
 
 const GDExtensionMethodInfo *get_method_list_func(LuaScriptInstance *p_instance, uint32_t *r_count) {
@@ -396,26 +455,244 @@ GDExtensionScriptInstanceInfo3 *LuaScriptInstance::get_script_instance_info() {
 }
 
 LuaScriptInstance *LuaScriptInstance::attached_to_object(Object *owner) {
-	if (LuaScriptInstance **ptr = owner_to_instance.getptr(owner)) {
-		return *ptr;
+	if (InstanceBinding *binding = get_instance_binding(owner, false)) {
+		return binding->instance;
 	}
 	else {
 		return nullptr;
 	}
 }
 
-static Variant _rawget(const Variant& self, const Variant& index) {
-	if (LuaScriptInstance *instance = LuaScriptInstance::attached_to_object(self)) {
-		return instance->data.get(index, Variant());
+// Instance bindings are stored inside the Object itself, so finding the
+// LuaScriptInstance attached to an Object needs no global map lookup.
+// The binding outlives script instances, which may be replaced or removed
+// while the Object is alive, so it only holds a pointer that gets cleared.
+void *LuaScriptInstance::instance_binding_create(void *token, void *instance) {
+	return memnew(InstanceBinding);
+}
+
+void LuaScriptInstance::instance_binding_free(void *token, void *instance, void *binding) {
+	memdelete((InstanceBinding *) binding);
+}
+
+GDExtensionBool LuaScriptInstance::instance_binding_reference(void *token, void *binding, GDExtensionBool reference) {
+	return true;
+}
+
+LuaScriptInstance::InstanceBinding *LuaScriptInstance::get_instance_binding(Object *owner, bool create) {
+	if (!owner) {
+		return nullptr;
+	}
+	// Passing no callbacks makes the engine return NULL instead of creating a new binding
+	return (InstanceBinding *) gdextension_interface::object_get_instance_binding(owner->_owner, &instance_binding_callbacks, create ? &instance_binding_callbacks : nullptr);
+}
+
+LuaScriptInstance *LuaScriptInstance::from_table(lua_State *L, int index) {
+	if (lua_type(L, index) != LUA_TTABLE) {
+		return nullptr;
+	}
+	index = lua_absindex(L, index);
+	lua_pushlightuserdata(L, &instance_key);
+	lua_rawget(L, index);
+	LuaScriptInstance *instance = (LuaScriptInstance *) lua_touserdata(L, -1);
+	lua_pop(L, 1);
+	return instance;
+}
+
+uint64_t LuaScriptInstance::get_live_instance_count() {
+	return live_instance_count.load(std::memory_order_relaxed);
+}
+
+const sol::table& LuaScriptInstance::get_variable_table(const StringName& name) const {
+	const LuaScriptProperty *property = script->get_metadata().properties.getptr(name);
+	if (property && property->has_accessors()) {
+		return accessor_table;
 	}
 	else {
-		return {};
+		return table;
+	}
+}
+
+bool LuaScriptInstance::get_variable(const StringName& name, Variant& r_value) const {
+	const sol::table& variables = get_variable_table(name);
+	if (!variables.valid()) {
+		return false;
 	}
+
+	lua_State *L = variables.lua_state();
+	StackTopChecker topcheck(L);
+	variables.push();
+	sol::stack::push(L, name);
+	lua_rawget(L, -2);
+	bool found = !lua_isnil(L, -1);
+	if (found) {
+		r_value = to_variant(L, -1);
+	}
+	lua_pop(L, 2);
+	return found;
+}
+
+void LuaScriptInstance::set_variable(const StringName& name, const Variant& value) {
+	if (&get_variable_table(name) == &accessor_table && !accessor_table.valid()) {
+		accessor_table = sol::state_view(table.lua_state()).create_table();
+	}
+	const sol::table& variables = get_variable_table(name);
+
+	lua_State *L = variables.lua_state();
+	StackTopChecker topcheck(L);
+	variables.push();
+	sol::stack::push(L, name);
+	lua_push(L, value);
+	lua_rawset(L, -3);
+	lua_pop(L, 1);
+}
+
+void LuaScriptInstance::clear_variables() {
+	lua_State *L = table.lua_state();
+	StackTopChecker topcheck(L);
+	table.push();
+	lua_pushnil(L);
+	while (lua_next(L, -2)) {
+		lua_pop(L, 1);
+		// keep the key used to find the LuaScriptInstance
+		if (lua_type(L, -1) != LUA_TLIGHTUSERDATA) {
+			lua_pushvalue(L, -1);
+			lua_pushnil(L);
+			lua_rawset(L, -4);
+		}
+	}
+	lua_pop(L, 1);
+	accessor_table = sol::table();
+
+	add_signal_variables();
+}
+
+void LuaScriptInstance::add_signal_variables() {
+	for (auto [name, signal] : script->get_metadata().signals) {
+		set_variable(name, Signal(owner, name));
+	}
+}
+
+bool LuaScriptInstance::push_table(lua_State *L) const {
+	if (!is_table_exposed || sol::main_thread(L, L) != sol::main_thread(table.lua_state(), table.lua_state())) {
+		return false;
+	}
+	table.push(L);
+	return true;
+}
+
+void LuaScriptInstance::push_method_bind(lua_State *L, const StringName& name) {
+	if (!method_binds.valid()) {
+		method_binds = sol::state_view(table.lua_state()).create_table();
+	}
+	sol::object method_bind = sol::make_object(L, LuaScriptInstanceMethodBind(this, name));
+	method_binds.raw_set(name, method_bind);
+	method_bind.push(L);
+}
+
+// `self` table metamethods
+// Raw fields are accessed directly by Lua, these only run for missing fields and new assignments.
+static int instance__index(lua_State *L) {
+	LuaScriptInstance *instance = LuaScriptInstance::from_table(L, 1);
+	if (!instance) {
+		return luaL_error(L, "Lua script instance is no longer valid");
+	}
+
+	if (lua_type(L, 2) == LUA_TSTRING) {
+		// a) method binds already created for this instance
+		if (instance->method_binds.valid()) {
+			instance->method_binds.push(L);
+			lua_pushvalue(L, 2);
+			lua_rawget(L, -2);
+			if (!lua_isnil(L, -1)) {
+				return 1;
+			}
+			lua_pop(L, 2);
+		}
+
+		StringName name = sol::stack::get<StringName>(L, 2);
+		const LuaScriptMetadata& metadata = instance->script->get_metadata();
+
+		// b) script methods, bound to the instance so they can be used as Callables
+		if (metadata.methods.has(name)) {
+			instance->push_method_bind(L, name);
+			return 1;
+		}
+
+		// c) script properties: getter, stored value or default value
+		if (const LuaScriptProperty *property = metadata.properties.getptr(name)) {
+			Variant value;
+			if (!property->get_value(instance, value) && !instance->get_variable(name, value)) {
+				value = property->instantiate_default_value();
+				// Same as in `get_func`: shared defaults are not stored, only per-instance copies need to be
+				if (!property->is_default_value_shared()) {
+					instance->set_variable(name, value);
+				}
+			}
+			lua_push(L, value);
+			return 1;
+		}
+	}
+
+	// d) fallback to owner Object, which handles native properties, methods and `_get`
+	instance->owner_userdata.push(L);
+	lua_pushvalue(L, 2);
+	lua_gettable(L, -2);
+	return 1;
+}
+
+static int instance__newindex(lua_State *L) {
+	LuaScriptInstance *instance = LuaScriptInstance::from_table(L, 1);
+	if (!instance) {
+		return luaL_error(L, "Lua script instance is no longer valid");
+	}
+
+	if (lua_type(L, 2) == LUA_TSTRING) {
+		StringName name = sol::stack::get<StringName>(L, 2);
+		if (const LuaScriptProperty *property = instance->script->get_metadata().properties.getptr(name)) {
+			// a) script properties with setter or getter are never stored in the table itself
+			if (property->has_accessors()) {
+				Variant value = to_variant(L, 3);
+				if (!property->set_value(instance, value)) {
+					instance->set_variable(name, value);
+				}
+				return 0;
+			}
+		}
+		else {
+			// b) unknown keys are set the same way Godot would: `_set`, owner properties, then raw data
+			Variant value = to_variant(L, 3);
+			set_func(instance, &name, &value);
+			return 0;
+		}
+	}
+
+	// c) plain script properties and non-string keys are stored as is
+	lua_settop(L, 3);
+	lua_rawset(L, 1);
+	return 0;
+}
+
+static int instance__tostring(lua_State *L) {
+	LuaScriptInstance *instance = LuaScriptInstance::from_table(L, 1);
+	if (!instance) {
+		return luaL_error(L, "Lua script instance is no longer valid");
+	}
+	sol::stack::push(L, instance->owner->to_string());
+	return 1;
+}
+
+static Variant _rawget(const Variant& self, const Variant& index) {
+	Variant value;
+	if (LuaScriptInstance *instance = LuaScriptInstance::attached_to_object(self)) {
+		instance->get_variable(index, value);
+	}
+	return value;
 }
 
 static void _rawset(const Variant& self, const Variant& index, const Variant& value) {
 	if (LuaScriptInstance *instance = LuaScriptInstance::attached_to_object(self)) {
-		instance->data[index] = value;
+		instance->set_variable(index, value);
 	}
 }
 
@@ -423,16 +700,28 @@ void LuaScriptInstance::register_lua(lua_State *L) {
 	sol::state_view state(L);
 	rawget = wrap_function(L, _rawget);
 	rawset = wrap_function(L, _rawset);
+	instance_metatable = state.create_table_with(
+		sol::meta_function::index, &instance__index,
+		sol::meta_function::new_index, &instance__newindex,
+		sol::meta_function::to_string, &instance__tostring
+	);
 	LuaScriptInstanceMethodBind::register_usertype(state);
 }
 
 void LuaScriptInstance::unregister_lua(lua_State *L) {
 	rawget = {};
 	rawset = {};
+	instance_metatable = {};
 }
 
-HashMap<Object *, LuaScriptInstance *> LuaScriptInstance::owner_to_instance;
+GDExtensionInstanceBindingCallbacks LuaScriptInstance::instance_binding_callbacks = {
+	LuaScriptInstance::instance_binding_create,
+	LuaScriptInstance::instance_binding_free,
+	LuaScriptInstance::instance_binding_reference,
+};
 sol::protected_function LuaScriptInstance::rawget;
 sol::protected_function LuaScriptInstance::rawset;
+sol::table LuaScriptInstance::instance_metatable;
+std::atomic<uint64_t> LuaScriptInstance::live_instance_count;
 
 }
@@ -23,9 +23,10 @@
 #define __LUA_SCRIPT_INSTANCE_HPP__
 
 #include <godot_cpp/classes/ref.hpp>
-#include <godot_cpp/templates/hash_map.hpp>
 #include "../utils/custom_sol.hpp"
 
+#include <atomic>
+
 using namespace godot;
 
 namespace luagdextension {
@@ -40,10 +41,30 @@ struct LuaScriptInstance {
 
 	static GDExtensionScriptInstanceInfo3 *get_script_instance_info();
 	static LuaScriptInstance *attached_to_object(Object *owner);
+	static LuaScriptInstance *from_table(lua_State *L, int index);
+	static uint64_t get_live_instance_count();
 
 	Object *owner;
 	Ref<LuaScript> script;
-	Dictionary data;
+	// Lua table that holds script variables as raw fields.
+	// It is used as `self` in Lua methods when the owner is not RefCounted,
+	// so that accessing script variables doesn't need to go through the engine.
+	sol::table table;
+	// Values for properties with getter/setter live outside `table`,
+	// otherwise assigning them from Lua would bypass `__newindex` and the setter
+	sol::table accessor_table;
+	// Method binds already pushed to Lua, cached by method name
+	sol::table method_binds;
+	// Owner as a Variant userdata, used by `self` table to fallback to native properties and methods
+	sol::object owner_userdata;
+	// Whether the owner is waiting in its script's instance pool
+	bool is_pooled;
+
+	bool get_variable(const StringName& name, Variant& r_value) const;
+	void set_variable(const StringName& name, const Variant& value);
+	void clear_variables();
+	bool push_table(lua_State *L) const;
+	void push_method_bind(lua_State *L, const StringName& name);
 
 	static void register_lua(lua_State *L);
 	static void unregister_lua(lua_State *L);
@@ -52,7 +73,22 @@ struct LuaScriptInstance {
 	static sol::protected_function rawset;
 
 private:
-	static HashMap<Object *, LuaScriptInstance *> owner_to_instance;
+	const sol::table& get_variable_table(const StringName& name) const;
+	void add_signal_variables();
+
+	bool is_table_exposed;
+
+	static sol::table instance_metatable;
+	static std::atomic<uint64_t> live_instance_count;
+
+	struct InstanceBinding {
+		LuaScriptInstance *instance = nullptr;
+	};
+	static void *instance_binding_create(void *token, void *instance);
+	static void instance_binding_free(void *token, void *instance, void *binding);
+	static GDExtensionBool instance_binding_reference(void *token, void *binding, GDExtensionBool reference);
+	static InstanceBinding *get_instance_binding(Object *owner, bool create);
+	static GDExtensionInstanceBindingCallbacks instance_binding_callbacks;
 };
 
 }
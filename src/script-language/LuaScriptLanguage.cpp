@@ -22,26 +22,53 @@
 #include "LuaScriptLanguage.hpp"
 
 #include "LuaScript.hpp"
+#include "LuaScriptImportBehaviorManager.hpp"
 #include "LuaScriptInstance.hpp"
 #include "LuaScriptMethod.hpp"
+#include "LuaScriptProfiler.hpp"
 #include "LuaScriptProperty.hpp"
 #include "LuaScriptSignal.hpp"
+#include "LuaScriptStaticAnalyzer.hpp"
 #include "../LuaError.hpp"
+#include "../LuaObject.hpp"
 #include "../LuaTable.hpp"
 #include "../LuaState.hpp"
 #include "../generated/lua_script_globals.h"
+#include "../utils/LuaCoroutinePool.hpp"
+#include "../utils/performance_counters.hpp"
 #include "../utils/project_settings.hpp"
 
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/performance.hpp>
 #include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/reg_ex.hpp>
 #include <godot_cpp/classes/reg_ex_match.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/time.hpp>
 #include <godot_cpp/variant/dictionary.hpp>
 #include <godot_cpp/variant/packed_string_array.hpp>
 
 namespace luagdextension {
 
+constexpr int GC_MAX_STEP_KB = 1024;
+// Parameters for the automatic collector while collection is budgeted per frame.
+// It only kicks in if frame steps fall far behind, like when frames stop being processed.
+constexpr int GC_BUDGETED_PAUSE = 1000;
+constexpr int GC_BUDGETED_MINOR_MULTIPLIER = 100;
+constexpr int GC_BUDGETED_MAJOR_MULTIPLIER = 1000;
+
+// Indexed by LuaScriptLanguage::PerformanceMonitor
+static const char *PERFORMANCE_MONITOR_NAMES[] = {
+	"Lua/Memory used (bytes)",
+	"Lua/GC cycles",
+	"Lua/GC frame time (usec)",
+	"Lua/LuaObject wrappers",
+	"Lua/Script instances",
+	"Lua/Coroutine pool size",
+	"Lua/Lua to Godot calls",
+	"Lua/Godot to Lua calls",
+};
+
 String LuaScriptLanguage::_get_name() const {
 	return "Lua";
 }
@@ -67,6 +94,9 @@ void LuaScriptLanguage::_init() {
 
 	// Additional globals defined in Lua code
 	lua_state->do_string(lua_script_globals);
+
+	setup_gc();
+	add_performance_monitors();
 }
 
 String LuaScriptLanguage::_get_type() const {
@@ -78,6 +108,8 @@ String LuaScriptLanguage::_get_extension() const {
 }
 
 void LuaScriptLanguage::_finish() {
+	remove_performance_monitors();
+	LuaScript::clear_instance_pools();
 	// Run a full GC to make sure we collect dead LuaScriptInstances, which reference this LuaState back and would leak
 	lua_state->get_lua_state().collect_garbage();
 	LuaScriptInstance::unregister_lua(lua_state->get_lua_state());
@@ -361,28 +393,69 @@ TypedArray<Dictionary> LuaScriptLanguage::_get_public_annotations() const {
 }
 
 void LuaScriptLanguage::_profiling_start() {
-	// TODO
+	MutexLock lock(lua_state_mutex);
+	LuaScriptProfiler::start(lua_state->get_lua_state().lua_state());
 }
 
 void LuaScriptLanguage::_profiling_stop() {
-	// TODO
+	LuaScriptProfiler::stop();
+}
+
+Dictionary LuaScriptLanguage::get_global_class_info(const String& path) const {
+	return _get_global_class_name(path);
+}
+
+Variant LuaScriptLanguage::get_static_global_class_info(const String& path) const {
+	Dictionary info;
+	if (LuaScriptStaticAnalyzer::get_global_class_info(path, info)) {
+		return info;
+	}
+	else {
+		return Variant();
+	}
+}
+
+void LuaScriptLanguage::save_script_analysis_cache() {
+	if (LuaScriptImportBehaviorManager *import_behavior_manager = LuaScriptImportBehaviorManager::get_singleton()) {
+		import_behavior_manager->save_analysis_cache();
+	}
+}
+
+void LuaScriptLanguage::profiling_start() {
+	_profiling_start();
+}
+
+void LuaScriptLanguage::profiling_stop() {
+	_profiling_stop();
+}
+
+Array LuaScriptLanguage::get_profiling_data() const {
+	return LuaScriptProfiler::get_accumulated_data_array();
 }
 
 void LuaScriptLanguage::_profiling_set_save_native_calls(bool p_enable) {
-	// TODO
+	LuaScriptProfiler::set_save_native_calls(p_enable);
 }
 
 int32_t LuaScriptLanguage::_profiling_get_accumulated_data(ScriptLanguageExtensionProfilingInfo *p_info_array, int32_t p_info_max) {
-	// TODO
-	return {};
+	return LuaScriptProfiler::get_accumulated_data(p_info_array, p_info_max);
 }
 
 int32_t LuaScriptLanguage::_profiling_get_frame_data(ScriptLanguageExtensionProfilingInfo *p_info_array, int32_t p_info_max) {
-	// TODO
-	return {};
+	return LuaScriptProfiler::get_frame_data(p_info_array, p_info_max);
 }
 
 void LuaScriptLanguage::_frame() {
+	lua_to_godot_calls_last_frame = lua_to_godot_call_count.exchange(0, std::memory_order_relaxed);
+	godot_to_lua_calls_last_frame = godot_to_lua_call_count.exchange(0, std::memory_order_relaxed);
+	if (LuaScriptProfiler::is_profiling()) {
+		LuaScriptProfiler::frame();
+	}
+
+	if (gc_frame_budget_usec > 0) {
+		MutexLock lock(lua_state_mutex);
+		step_gc_in_frame();
+	}
 }
 
 bool LuaScriptLanguage::_handles_global_class_type(const String &type) const {
@@ -390,9 +463,18 @@ bool LuaScriptLanguage::_handles_global_class_type(const String &type) const {
 }
 
 Dictionary LuaScriptLanguage::_get_global_class_name(const String &path) const {
-	Ref<LuaScript> script = ResourceLoader::get_singleton()->load(path);
-	
 	Dictionary result;
+	LuaScriptImportBehaviorManager *import_behavior_manager = LuaScriptImportBehaviorManager::get_singleton();
+	if (import_behavior_manager && import_behavior_manager->get_script_import_behavior(path) == LuaScript::IMPORT_BEHAVIOR_DONT_LOAD) {
+		return result;
+	}
+
+	// Avoid executing scripts during filesystem scans whenever their metadata is declared statically
+	if (!ResourceLoader::get_singleton()->has_cached(path) && LuaScriptStaticAnalyzer::get_global_class_info(path, result)) {
+		return result;
+	}
+
+	Ref<LuaScript> script = ResourceLoader::get_singleton()->load(path);
 	if (script.is_valid() && script->_is_valid()) {
 		result["name"] = script->_get_global_name();
 		result["base_type"] = script->_get_instance_base_type();
@@ -435,6 +517,130 @@ LuaParser *LuaScriptLanguage::get_lua_parser() const {
 	return lua_parser.ptr();
 }
 
+void LuaScriptLanguage::add_performance_monitors() {
+	Performance *performance = Performance::get_singleton();
+	for (int i = 0; i < MONITOR_MAX; i++) {
+		performance->add_custom_monitor(PERFORMANCE_MONITOR_NAMES[i], callable_mp(this, &LuaScriptLanguage::get_performance_monitor), Array::make(i));
+	}
+}
+
+void LuaScriptLanguage::remove_performance_monitors() {
+	Performance *performance = Performance::get_singleton();
+	for (int i = 0; i < MONITOR_MAX; i++) {
+		if (performance->has_custom_monitor(PERFORMANCE_MONITOR_NAMES[i])) {
+			performance->remove_custom_monitor(PERFORMANCE_MONITOR_NAMES[i]);
+		}
+	}
+}
+
+uint64_t LuaScriptLanguage::get_performance_monitor(int monitor) {
+	switch (monitor) {
+		case MONITOR_MEMORY_USED: {
+			// Scripts may be evaluating in loading threads
+			MutexLock lock(lua_state_mutex);
+			return lua_state->get_memory_used();
+		}
+		case MONITOR_GC_CYCLES:
+			return lua_state->get_gc_cycle_count();
+		case MONITOR_GC_FRAME_TIME:
+			return gc_frame_usec;
+		case MONITOR_LUA_OBJECTS:
+			return LuaObject::get_known_object_count();
+		case MONITOR_SCRIPT_INSTANCES:
+			return LuaScriptInstance::get_live_instance_count();
+		case MONITOR_COROUTINE_POOL_SIZE: {
+			MutexLock lock(lua_state_mutex);
+			return LuaCoroutinePool(lua_state->get_lua_state()).get_size();
+		}
+		case MONITOR_LUA_TO_GODOT_CALLS:
+			return lua_to_godot_calls_last_frame;
+		case MONITOR_GODOT_TO_LUA_CALLS:
+			return godot_to_lua_calls_last_frame;
+		default:
+			ERR_FAIL_V_MSG(0, "Invalid performance monitor");
+	}
+}
+
+void LuaScriptLanguage::setup_gc() {
+	ProjectSettings *project_settings = ProjectSettings::get_singleton();
+	LuaState::GcMode gc_mode = (LuaState::GcMode) (int) project_settings->get_setting_with_override(LUA_SCRIPT_GC_MODE_SETTING);
+	if (!lua_state->supports_gc_mode(gc_mode)) {
+		WARN_PRINT(String("Garbage collection mode from '%s' is not supported by %s runtime, using incremental mode instead") % Array::make(LUA_SCRIPT_GC_MODE_SETTING, LuaState::get_lua_runtime()));
+		gc_mode = LuaState::GC_MODE_INCREMENTAL;
+	}
+	gc_generational = gc_mode == LuaState::GC_MODE_GENERATIONAL;
+
+	int64_t frame_budget_usec = project_settings->get_setting_with_override(LUA_SCRIPT_GC_FRAME_BUDGET_SETTING);
+	gc_frame_budget_usec = MAX(frame_budget_usec, 0);
+	if (gc_frame_budget_usec > 0) {
+		// The collector mostly runs in `_frame`, but automatic collection stays alive with a large pause
+		if (gc_generational) {
+			lua_state->change_gc_mode_generational(GC_BUDGETED_MINOR_MULTIPLIER, GC_BUDGETED_MAJOR_MULTIPLIER);
+		}
+		else {
+			lua_state->change_gc_mode_incremental(GC_BUDGETED_PAUSE, 0, 0);
+		}
+		gc_last_memory_used = lua_state->get_memory_used();
+	}
+	// Zeros keep the runtime's default parameters
+	else if (gc_generational) {
+		lua_state->change_gc_mode_generational(0, 0);
+	}
+	else {
+		lua_state->change_gc_mode_incremental(0, 0, 0);
+	}
+}
+
+void LuaScriptLanguage::step_gc_in_frame() {
+	Time *time = Time::get_singleton();
+	uint64_t start_usec = time->get_ticks_usec();
+	lua_State *L = lua_state->get_lua_state();
+
+	// Collect twice as much memory as was allocated since the last frame, like Lua's default step multiplier.
+	// Debt not paid within the budget is carried over to the next frames.
+	uint64_t memory_used = lua_state->get_memory_used();
+	if (memory_used > gc_last_memory_used) {
+		gc_debt_kb += 2 * (int64_t) ((memory_used - gc_last_memory_used) / 1024);
+	}
+	gc_last_memory_used = memory_used;
+	if (gc_debt_kb == 0) {
+		gc_frame_usec = 0;
+		return;
+	}
+	// When collection falls behind by a whole heap, ignore the budget instead of letting memory grow unbounded
+	bool ignore_budget = gc_debt_kb * 1024 > (int64_t) memory_used;
+
+	uint64_t elapsed_usec = 0;
+	int steps = 0;
+	do {
+		bool cycle_finished = lua_gc(L, LUA_GCSTEP, gc_step_kb);
+		steps++;
+		elapsed_usec = time->get_ticks_usec() - start_usec;
+		// In generational mode each step is a whole minor collection, so one per frame is enough
+		if (cycle_finished || gc_generational) {
+			gc_debt_kb = 0;
+			break;
+		}
+		gc_debt_kb = MAX(gc_debt_kb - gc_step_kb, 0);
+	} while (gc_debt_kb > 0 && (ignore_budget || elapsed_usec < gc_frame_budget_usec));
+
+	// Adapt the step size so that a single step takes around an eighth of the budget
+	uint64_t step_usec = elapsed_usec / steps;
+	if (step_usec > gc_frame_budget_usec / 4 && gc_step_kb > 1) {
+		gc_step_kb /= 2;
+	}
+	else if (step_usec < gc_frame_budget_usec / 16 && gc_step_kb < GC_MAX_STEP_KB) {
+		gc_step_kb *= 2;
+	}
+
+	gc_last_memory_used = lua_state->get_memory_used();
+	gc_frame_usec = elapsed_usec;
+}
+
+Mutex& LuaScriptLanguage::get_lua_state_mutex() {
+	return lua_state_mutex;
+}
+
 LuaScriptLanguage *LuaScriptLanguage::get_singleton() {
 	return instance;
 }
@@ -456,6 +662,12 @@ void LuaScriptLanguage::delete_singleton() {
 }
 
 void LuaScriptLanguage::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_global_class_info", "path"), &LuaScriptLanguage::get_global_class_info);
+	ClassDB::bind_method(D_METHOD("get_static_global_class_info", "path"), &LuaScriptLanguage::get_static_global_class_info);
+	ClassDB::bind_method(D_METHOD("save_script_analysis_cache"), &LuaScriptLanguage::save_script_analysis_cache);
+	ClassDB::bind_method(D_METHOD("profiling_start"), &LuaScriptLanguage::profiling_start);
+	ClassDB::bind_method(D_METHOD("profiling_stop"), &LuaScriptLanguage::profiling_stop);
+	ClassDB::bind_method(D_METHOD("get_profiling_data"), &LuaScriptLanguage::get_profiling_data);
 }
 
 LuaScriptLanguage *LuaScriptLanguage::instance = nullptr;
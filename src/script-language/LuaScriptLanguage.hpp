@@ -24,6 +24,7 @@
 
 #include <godot_cpp/classes/script.hpp>
 #include <godot_cpp/classes/script_language_extension.hpp>
+#include <godot_cpp/core/mutex.hpp>
 
 #include "../LuaParser.hpp"
 #include "../LuaState.hpp"
@@ -102,6 +103,17 @@ public:
 
 	LuaState *get_lua_state();
 	LuaParser *get_lua_parser() const;
+	Mutex& get_lua_state_mutex();
+
+	// Global class info, as used by the editor filesystem scan
+	Dictionary get_global_class_info(const String& path) const;
+	Variant get_static_global_class_info(const String& path) const;
+	void save_script_analysis_cache();
+
+	// Script profiler, also used by the editor debugger
+	void profiling_start();
+	void profiling_stop();
+	Array get_profiling_data() const;
 
 	static LuaScriptLanguage *get_singleton();
 	static LuaScriptLanguage *get_or_create_singleton();
@@ -112,8 +124,38 @@ protected:
 
 	Ref<LuaState> lua_state;
 	Ref<LuaParser> lua_parser;
+	// Serializes access to the Lua state by scripts loading in other threads
+	Mutex lua_state_mutex;
 	Dictionary named_globals;
 
+	// Frame budgeted garbage collection, disabled when the budget is zero
+	void setup_gc();
+	void step_gc_in_frame();
+	uint64_t gc_frame_budget_usec = 0;
+	uint64_t gc_frame_usec = 0;
+	uint64_t gc_last_memory_used = 0;
+	int64_t gc_debt_kb = 0;
+	bool gc_generational = false;
+	int gc_step_kb = 1;
+
+	// Custom monitors shown in Godot's Performance singleton
+	enum PerformanceMonitor {
+		MONITOR_MEMORY_USED,
+		MONITOR_GC_CYCLES,
+		MONITOR_GC_FRAME_TIME,
+		MONITOR_LUA_OBJECTS,
+		MONITOR_SCRIPT_INSTANCES,
+		MONITOR_COROUTINE_POOL_SIZE,
+		MONITOR_LUA_TO_GODOT_CALLS,
+		MONITOR_GODOT_TO_LUA_CALLS,
+		MONITOR_MAX,
+	};
+	void add_performance_monitors();
+	void remove_performance_monitors();
+	uint64_t get_performance_monitor(int monitor);
+	uint64_t lua_to_godot_calls_last_frame = 0;
+	uint64_t godot_to_lua_calls_last_frame = 0;
+
 private:
 	static LuaScriptLanguage *instance;
 };
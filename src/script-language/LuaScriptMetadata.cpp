@@ -24,6 +24,7 @@
 #include <godot_cpp/classes/ref_counted.hpp>
 #include <godot_cpp/core/class_db.hpp>
 
+#include "LuaScript.hpp"
 #include "LuaScriptInstance.hpp"
 #include "../utils/convert_godot_lua.hpp"
 #include "../utils/stack_top_resetter.hpp"
@@ -65,13 +66,19 @@ void LuaScriptMetadata::setup(const sol::table& t) {
 
 			String name = key.as<String>();
 			if (name == "extends") {
-				StringName extends = to_variant(value);
-				if (!ClassDB::class_exists(extends)) {
-					WARN_PRINT(String("Specified base class '%s' does not exist, using RefCounted") % Array::make(extends));
+				Variant extends = to_variant(value);
+				if (LuaScript *script = Object::cast_to<LuaScript>(extends)) {
+					base_script_path = script->get_path();
 				}
-				else {
+				else if (ClassDB::class_exists(extends)) {
 					base_class = extends;
 				}
+				else if (String extends_path = extends; extends_path.ends_with(".lua") || extends_path.begins_with("uid://")) {
+					base_script_path = extends_path;
+				}
+				else {
+					WARN_PRINT(String("Specified base class '%s' does not exist, using RefCounted") % Array::make(extends));
+				}
 			}
 			else if (name == "class_name") {
 				class_name = to_variant(value);
@@ -115,10 +122,43 @@ void LuaScriptMetadata::setup(const sol::table& t) {
 	}
 }
 
+void LuaScriptMetadata::inherit(const LuaScriptMetadata& base) {
+	base_class = base.base_class;
+	if (icon_path.is_empty()) {
+		icon_path = base.icon_path;
+	}
+	if (rpc_config.get_type() == Variant::DICTIONARY && base.rpc_config.get_type() == Variant::DICTIONARY) {
+		Dictionary merged_rpc_config = base.rpc_config.duplicate();
+		merged_rpc_config.merge(rpc_config, true);
+		rpc_config = merged_rpc_config;
+	}
+	else if (rpc_config.get_type() == Variant::NIL) {
+		rpc_config = base.rpc_config;
+	}
+
+	// Flatten members from the base script, so that each lookup is a single hash lookup
+	for (const auto& [name, method] : base.methods) {
+		if (!methods.has(name)) {
+			methods.insert(name, method);
+		}
+	}
+	for (const auto& [name, property] : base.properties) {
+		if (!properties.has(name)) {
+			properties.insert(name, property);
+		}
+	}
+	for (const auto& [name, signal] : base.signals) {
+		if (!signals.has(name)) {
+			signals.insert(name, signal);
+		}
+	}
+}
+
 void LuaScriptMetadata::clear() {
 	is_valid = false;
 	is_tool = false;
 	base_class = RefCounted::get_class_static();
+	base_script_path = String();
 	class_name = StringName();
 	icon_path = String();
 	rpc_config = Variant();
@@ -36,6 +36,7 @@ struct LuaScriptMetadata {
 	bool is_valid;
 	bool is_tool;
 	StringName base_class;
+	String base_script_path;
 	StringName class_name;
 	String icon_path;
 	Variant rpc_config;
@@ -44,6 +45,7 @@ struct LuaScriptMetadata {
 	HashMap<StringName, LuaScriptSignal> signals;
 
 	void setup(const sol::table& t);
+	void inherit(const LuaScriptMetadata& base);
 	void clear();
 
 	static void register_lua(lua_State *L);
@@ -0,0 +1,318 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaScriptProfiler.hpp"
+
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/core/mutex.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+namespace luagdextension {
+
+struct FunctionProfile {
+	StringName signature;
+	uint64_t call_count = 0;
+	uint64_t total_usec = 0;
+	uint64_t self_usec = 0;
+	uint64_t frame_call_count = 0;
+	uint64_t frame_total_usec = 0;
+	uint64_t frame_self_usec = 0;
+};
+
+struct FunctionCacheEntry {
+	int profile_index;
+	// Validates the entry, since function addresses may be reused after they are collected
+	const char *source;
+	int linedefined;
+};
+
+struct ProfilerFrame {
+	// -1 for native functions when native calls are not saved
+	int profile_index;
+	// Stack level of the function, used to detect frames unwound by errors
+	int depth;
+	uint64_t start_usec;
+	uint64_t children_usec;
+	bool is_tail_call;
+};
+
+struct ProfilerThread {
+	LocalVector<ProfilerFrame> frames;
+	uint64_t suspended_usec = 0;
+};
+
+static Mutex profiler_mutex;
+static bool save_native_calls = false;
+static LocalVector<FunctionProfile> function_profiles;
+static HashMap<StringName, int> profile_indices;
+static HashMap<const void *, FunctionCacheEntry> function_cache;
+static HashMap<lua_State *, ProfilerThread> profiler_threads;
+
+static uint64_t get_ticks_usec() {
+	return Time::get_singleton()->get_ticks_usec();
+}
+
+static int get_profile_index(lua_State *L, lua_Debug *ar) {
+	lua_getinfo(L, "Snf", ar);
+	const void *function = lua_topointer(L, -1);
+	lua_pop(L, 1);
+	if (ar->what[0] == 'C' && !save_native_calls) {
+		return -1;
+	}
+	if (const FunctionCacheEntry *entry = function_cache.getptr(function); entry && entry->source == ar->source && entry->linedefined == ar->linedefined) {
+		return entry->profile_index;
+	}
+
+	// Same format used by GDScript: "source::line::name"
+	String source = ar->source[0] == '@' ? String::utf8(ar->source + 1) : String::utf8(ar->short_src);
+	StringName signature = String("%s::%d::%s") % Array::make(source, MAX(ar->linedefined, 0), ar->name ? ar->name : "?");
+	int profile_index;
+	if (const int *index = profile_indices.getptr(signature)) {
+		profile_index = *index;
+	}
+	else {
+		profile_index = function_profiles.size();
+		FunctionProfile profile;
+		profile.signature = signature;
+		function_profiles.push_back(profile);
+		profile_indices.insert(signature, profile_index);
+	}
+	function_cache.insert(function, { profile_index, ar->source, ar->linedefined });
+	return profile_index;
+}
+
+// Levels are counted with a binary search, since `lua_getstack` walks the call stack on every call
+static int get_stack_depth(lua_State *L) {
+	lua_Debug ar;
+	int low = 0, high = 1;
+	while (lua_getstack(L, high, &ar)) {
+		low = high;
+		high *= 2;
+	}
+	while (high - low > 1) {
+		int middle = (low + high) / 2;
+		if (lua_getstack(L, middle, &ar)) {
+			low = middle;
+		}
+		else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+static void pop_frame(ProfilerThread& thread, uint64_t now_usec) {
+	ProfilerFrame frame = thread.frames[thread.frames.size() - 1];
+	thread.frames.remove_at(thread.frames.size() - 1);
+	uint64_t total_usec = now_usec - frame.start_usec;
+	uint64_t self_usec = total_usec > frame.children_usec ? total_usec - frame.children_usec : 0;
+	if (frame.profile_index >= 0) {
+		FunctionProfile& profile = function_profiles[frame.profile_index];
+		profile.call_count++;
+		profile.total_usec += total_usec;
+		profile.self_usec += self_usec;
+		profile.frame_call_count++;
+		profile.frame_total_usec += total_usec;
+		profile.frame_self_usec += self_usec;
+	}
+	if (!thread.frames.is_empty()) {
+		// Time spent in skipped native functions counts as self time of their callers
+		thread.frames[thread.frames.size() - 1].children_usec += frame.profile_index >= 0 ? total_usec : frame.children_usec;
+	}
+}
+
+// Errors unwind functions without calling return hooks, so frames deeper than the current function are stale.
+// They are accounted as returning now, which is the closest we know about when they were unwound.
+static void pop_stale_frames(ProfilerThread& thread, int depth, uint64_t now_usec) {
+	while (!thread.frames.is_empty() && thread.frames[thread.frames.size() - 1].depth > depth) {
+		pop_frame(thread, now_usec);
+	}
+}
+
+static void profiler_hook(lua_State *L, lua_Debug *ar) {
+	if (!LuaScriptProfiler::is_profiling()) {
+		lua_sethook(L, nullptr, 0, 0);
+		return;
+	}
+
+	uint64_t now_usec = get_ticks_usec();
+	MutexLock lock(profiler_mutex);
+	ProfilerThread& thread = profiler_threads[L];
+	switch (ar->event) {
+		case LUA_HOOKCALL:
+#ifdef LUA_HOOKTAILCALL
+		case LUA_HOOKTAILCALL:
+#endif
+		{
+			int depth = get_stack_depth(L);
+#ifdef LUA_HOOKTAILCALL
+			bool is_tail_call = ar->event == LUA_HOOKTAILCALL;
+#else
+			bool is_tail_call = false;
+#endif
+			// Tail calls reuse the level of the function they replace, which is still active
+			pop_stale_frames(thread, is_tail_call ? depth : depth - 1, now_usec);
+			int profile_index = get_profile_index(L, ar);
+			thread.frames.push_back({ profile_index, depth, get_ticks_usec(), 0, is_tail_call });
+			break;
+		}
+
+		case LUA_HOOKRET: {
+			pop_stale_frames(thread, get_stack_depth(L), now_usec);
+			// Functions replaced by tail calls return together with the function that replaced them
+			bool is_tail_call = true;
+			while (is_tail_call && !thread.frames.is_empty()) {
+				is_tail_call = thread.frames[thread.frames.size() - 1].is_tail_call;
+				pop_frame(thread, now_usec);
+			}
+			break;
+		}
+
+#ifdef LUA_HOOKTAILRET
+		case LUA_HOOKTAILRET:
+			if (!thread.frames.is_empty()) {
+				pop_frame(thread, now_usec);
+			}
+			break;
+#endif
+	}
+}
+
+static void install_hook(lua_State *L) {
+	// Don't override hooks set by users
+	if (lua_gethook(L) == nullptr) {
+		lua_sethook(L, profiler_hook, LUA_MASKCALL | LUA_MASKRET, 0);
+	}
+}
+
+void LuaScriptProfiler::start(lua_State *L) {
+	MutexLock lock(profiler_mutex);
+	function_profiles.clear();
+	profile_indices.clear();
+	function_cache.clear();
+	profiler_threads.clear();
+	profiling.store(true, std::memory_order_relaxed);
+	install_hook(L);
+}
+
+void LuaScriptProfiler::stop() {
+	// Hooks remove themselves on their next call
+	MutexLock lock(profiler_mutex);
+	profiling.store(false, std::memory_order_relaxed);
+	profiler_threads.clear();
+}
+
+void LuaScriptProfiler::set_save_native_calls(bool p_save_native_calls) {
+	MutexLock lock(profiler_mutex);
+	save_native_calls = p_save_native_calls;
+	function_cache.clear();
+}
+
+int32_t LuaScriptProfiler::get_accumulated_data(ScriptLanguageExtensionProfilingInfo *info_array, int32_t info_max) {
+	MutexLock lock(profiler_mutex);
+	int32_t count = 0;
+	for (const FunctionProfile& profile : function_profiles) {
+		if (count >= info_max) {
+			break;
+		}
+		if (profile.call_count > 0) {
+			info_array[count].signature = profile.signature;
+			info_array[count].call_count = profile.call_count;
+			info_array[count].total_time = profile.total_usec;
+			info_array[count].self_time = profile.self_usec;
+			count++;
+		}
+	}
+	return count;
+}
+
+Array LuaScriptProfiler::get_accumulated_data_array() {
+	MutexLock lock(profiler_mutex);
+	Array data;
+	for (const FunctionProfile& profile : function_profiles) {
+		if (profile.call_count > 0) {
+			Dictionary info;
+			info["signature"] = profile.signature;
+			info["call_count"] = profile.call_count;
+			info["total_time"] = profile.total_usec;
+			info["self_time"] = profile.self_usec;
+			data.append(info);
+		}
+	}
+	return data;
+}
+
+int32_t LuaScriptProfiler::get_frame_data(ScriptLanguageExtensionProfilingInfo *info_array, int32_t info_max) {
+	MutexLock lock(profiler_mutex);
+	int32_t count = 0;
+	for (const FunctionProfile& profile : function_profiles) {
+		if (count >= info_max) {
+			break;
+		}
+		if (profile.frame_call_count > 0) {
+			info_array[count].signature = profile.signature;
+			info_array[count].call_count = profile.frame_call_count;
+			info_array[count].total_time = profile.frame_total_usec;
+			info_array[count].self_time = profile.frame_self_usec;
+			count++;
+		}
+	}
+	return count;
+}
+
+void LuaScriptProfiler::frame() {
+	MutexLock lock(profiler_mutex);
+	for (FunctionProfile& profile : function_profiles) {
+		profile.frame_call_count = 0;
+		profile.frame_total_usec = 0;
+		profile.frame_self_usec = 0;
+	}
+}
+
+void LuaScriptProfiler::thread_resuming(lua_State *L) {
+	install_hook(L);
+	MutexLock lock(profiler_mutex);
+	if (ProfilerThread *thread = profiler_threads.getptr(L); thread && thread->suspended_usec > 0) {
+		uint64_t suspended_for_usec = get_ticks_usec() - thread->suspended_usec;
+		for (ProfilerFrame& frame : thread->frames) {
+			frame.start_usec += suspended_for_usec;
+		}
+		thread->suspended_usec = 0;
+	}
+}
+
+void LuaScriptProfiler::thread_suspended(lua_State *L, bool yielded) {
+	MutexLock lock(profiler_mutex);
+	if (yielded) {
+		if (ProfilerThread *thread = profiler_threads.getptr(L)) {
+			thread->suspended_usec = get_ticks_usec();
+		}
+	}
+	else {
+		// Finished or errored, frames unwound by errors never get their return hooks called
+		profiler_threads.erase(L);
+	}
+}
+
+std::atomic<bool> LuaScriptProfiler::profiling;
+
+}
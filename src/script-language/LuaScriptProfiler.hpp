@@ -0,0 +1,67 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_SCRIPT_PROFILER_HPP__
+#define __LUA_SCRIPT_PROFILER_HPP__
+
+#include <godot_cpp/classes/script_language_extension.hpp>
+
+#include <lua.h>
+
+#include <atomic>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Implementation of Godot's script profiler for Lua, based on call and return hooks.
+ *
+ * Hooks are only installed while profiling, in the script language state and in coroutines resumed from Godot.
+ * Threads that already have a hook, like the ones set by `LuaThread.set_hook`, are not profiled.
+ */
+class LuaScriptProfiler {
+public:
+	static bool is_profiling() {
+		return profiling.load(std::memory_order_relaxed);
+	}
+
+	static void start(lua_State *L);
+	static void stop();
+	static void set_save_native_calls(bool save_native_calls);
+	static int32_t get_accumulated_data(ScriptLanguageExtensionProfilingInfo *info_array, int32_t info_max);
+	static int32_t get_frame_data(ScriptLanguageExtensionProfilingInfo *info_array, int32_t info_max);
+	// Same as `get_accumulated_data`, as an Array of Dictionaries
+	static Array get_accumulated_data_array();
+	static void frame();
+
+	// Should only be called while profiling.
+	// Time spent while coroutines are suspended is not accounted for.
+	static void thread_resuming(lua_State *L);
+	static void thread_suspended(lua_State *L, bool yielded);
+
+private:
+	static std::atomic<bool> profiling;
+};
+
+}
+
+#endif  // __LUA_SCRIPT_PROFILER_HPP__
@@ -209,6 +209,10 @@ LuaScriptProperty::LuaScriptProperty(const Variant& value, const StringName& nam
 {
 }
 
+bool LuaScriptProperty::has_accessors() const {
+	return getter.valid() || setter.valid() || !getter_name.is_empty() || !setter_name.is_empty();
+}
+
 bool LuaScriptProperty::get_value(LuaScriptInstance *self, Variant& r_value) const {
 	if (getter.valid()) {
 		r_value = LuaFunction::invoke_lua(getter, VariantArguments(self->owner, nullptr, 0), false);
@@ -224,14 +228,26 @@ bool LuaScriptProperty::get_value(LuaScriptInstance *self, Variant& r_value) con
 }
 
 Variant LuaScriptProperty::instantiate_default_value() const {
-	if (default_value.get_type() == type) {
-		return default_value.duplicate();
+	if (default_value.get_type() != type) {
+		return VariantType(type).construct_default();
+	}
+	else if (is_default_value_shared()) {
+		return default_value;
 	}
 	else {
-		return VariantType(type).construct_default();
+		// Shallow copy, nested containers are shared just like the top level ones were before being copied
+		return default_value.duplicate(false);
 	}
 }
 
+bool LuaScriptProperty::is_default_value_shared() const {
+	// Arrays and Dictionaries are passed by reference, so each instance needs its own copy.
+	// Unlike Packed Arrays, they are not copy-on-write in Godot and any caller could modify a shared default,
+	// so they are copied when first accessed instead.
+	// Every other type is either passed by value or copy-on-write, like Packed Arrays.
+	return type != Variant::ARRAY && type != Variant::DICTIONARY;
+}
+
 bool LuaScriptProperty::set_value(LuaScriptInstance *self, const Variant& value) const {
 	if (setter.valid()) {
 		LuaCoroutine::invoke_lua(setter, Array::make(self->owner, value), false);
@@ -54,9 +54,11 @@ struct LuaScriptProperty {
 	sol::protected_function getter;  // Variant getter(self)
 	sol::protected_function setter;  // void setter(self, Variant value)
 
+	bool has_accessors() const;
 	bool get_value(LuaScriptInstance *self, Variant& r_value) const;
 	bool set_value(LuaScriptInstance *self, const Variant& value) const;
 	Variant instantiate_default_value() const;
+	bool is_default_value_shared() const;
 
 	PropertyInfo to_property_info() const;
 	Dictionary to_dictionary() const;
@@ -20,10 +20,12 @@
  * SOFTWARE.
  */
 #include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
 #include <godot_cpp/classes/script.hpp>
 
 #include "LuaScript.hpp"
+#include "LuaScriptBytecodeArchive.hpp"
 #include "LuaScriptLanguage.hpp"
 #include "LuaScriptResourceFormatLoader.hpp"
 
@@ -49,7 +51,8 @@ String LuaScriptResourceFormatLoader::_get_resource_type(const String &p_path) c
 }
 
 bool LuaScriptResourceFormatLoader::_exists(const String &p_path) const {
-	return FileAccess::file_exists(p_path);
+	LuaScriptBytecodeArchive *archive = LuaScriptBytecodeArchive::get_singleton();
+	return (archive && archive->has_file(p_path)) || FileAccess::file_exists(p_path);
 }
 
 Variant LuaScriptResourceFormatLoader::_load(const String &p_path, const String &p_original_path, bool p_use_sub_threads, int32_t p_cache_mode) const {
@@ -59,6 +62,8 @@ Variant LuaScriptResourceFormatLoader::_load(const String &p_path, const String
 	switch (p_cache_mode) {
 		case ResourceFormatLoader::CACHE_MODE_IGNORE:
 		case ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP:
+			// Path is still needed for chunk names and precompiled bytecode lookups
+			script->set_path_cache(p_original_path);
 			break;
 
 		case ResourceFormatLoader::CACHE_MODE_REUSE: {
@@ -78,7 +83,17 @@ Variant LuaScriptResourceFormatLoader::_load(const String &p_path, const String
 			break;
 	}
 
-	script->set_source_code(FileAccess::get_file_as_string(p_path));
+	// Setting source code bytes directly avoids a UTF-8 roundtrip and reloading the script twice
+	// Precompiled scripts in exported projects don't ship their source file
+	LuaScriptBytecodeArchive *archive = LuaScriptBytecodeArchive::get_singleton();
+	if (!archive || !archive->has_file(p_original_path)) {
+		script->set_source_code_utf8(FileAccess::get_file_as_bytes(p_path));
+		// Compiling doesn't touch the shared Lua state, so scripts loading in other threads compile in parallel
+		OS *os = OS::get_singleton();
+		if (p_use_sub_threads || os->get_thread_caller_id() != os->get_main_thread_id()) {
+			script->precompile(p_use_sub_threads);
+		}
+	}
 	Error status = script->reload();
 	if (status == OK) {
 		return script;
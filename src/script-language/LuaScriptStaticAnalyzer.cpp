@@ -0,0 +1,331 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaScriptStaticAnalyzer.hpp"
+
+#include "../LuaAST.hpp"
+#include "../LuaASTNode.hpp"
+#include "../LuaParser.hpp"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/resource_uid.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+namespace luagdextension {
+
+// Avoids infinite recursion on cyclic inheritance
+constexpr int MAX_INHERITANCE_DEPTH = 32;
+
+struct StaticClassInfo {
+	String class_name;
+	String base_type = "RefCounted";
+	String base_script_path;
+	String icon_path;
+	bool is_tool = false;
+};
+
+static bool get_class_info(const String& path, StaticClassInfo& r_info, int depth);
+
+static bool read_string_literal(const Ref<LuaASTNode>& node, String& r_value) {
+	if (node.is_null() || node->get_type() != "string") {
+		return false;
+	}
+	Ref<LuaASTNode> content = node->get_child_by_field_name("content");
+	r_value = content.is_valid() ? content->get_source_code() : String();
+	// Escape sequences are not processed, so leave strings that have them for the Lua runtime
+	return !r_value.contains("\\");
+}
+
+static bool is_metadata_key(const String& key) {
+	return key == "class_name" || key == "extends" || key == "icon" || key == "tool";
+}
+
+static bool read_metadata_field(const String& key, const Ref<LuaASTNode>& value, StaticClassInfo& info) {
+	if (!is_metadata_key(key)) {
+		return true;
+	}
+	if (value.is_null()) {
+		return false;
+	}
+
+	String string_value;
+	if (key == "class_name") {
+		if (!read_string_literal(value, info.class_name)) {
+			return false;
+		}
+	}
+	else if (key == "extends") {
+		if (value->get_type() == "identifier") {
+			string_value = value->get_source_code();
+		}
+		else if (!read_string_literal(value, string_value)) {
+			return false;
+		}
+
+		if (ClassDB::class_exists(string_value)) {
+			info.base_type = string_value;
+			info.base_script_path = String();
+		}
+		else if (value->get_type() == "string" && (string_value.ends_with(".lua") || string_value.begins_with("uid://"))) {
+			info.base_script_path = string_value;
+		}
+		else {
+			// Local variables and script global classes are known only at runtime
+			return false;
+		}
+	}
+	else if (key == "icon") {
+		if (!read_string_literal(value, info.icon_path)) {
+			return false;
+		}
+	}
+	else if (key == "tool") {
+		String type = value->get_type();
+		if (type != "true" && type != "false") {
+			return false;
+		}
+		info.is_tool = type == "true";
+	}
+	return true;
+}
+
+static bool read_table_constructor(const Ref<LuaASTNode>& table, StaticClassInfo& info) {
+	for (uint32_t i = 0; i < table->get_named_child_count(); i++) {
+		Ref<LuaASTNode> field = table->get_named_child(i);
+		if (field->get_type() != "field") {
+			continue;
+		}
+		Ref<LuaASTNode> name = field->get_child_by_field_name("name");
+		if (name.is_null()) {
+			// Positional values are not metadata
+			continue;
+		}
+
+		String key;
+		if (name->get_type() == "identifier") {
+			key = name->get_source_code();
+		}
+		else if (name->get_type() == "number") {
+			continue;
+		}
+		else if (!read_string_literal(name, key)) {
+			return false;
+		}
+		if (!read_metadata_field(key, field->get_child_by_field_name("value"), info)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Returns true if the value is a new metadata table: either a table constructor or `GDCLASS()`
+static bool read_class_table(const Ref<LuaASTNode>& value, StaticClassInfo& info) {
+	if (value.is_null()) {
+		return false;
+	}
+	info = StaticClassInfo();
+	if (value->get_type() == "table_constructor") {
+		return read_table_constructor(value, info);
+	}
+	else if (value->get_type() == "function_call") {
+		Ref<LuaASTNode> name = value->get_child_by_field_name("name");
+		Ref<LuaASTNode> arguments = value->get_child_by_field_name("arguments");
+		return name.is_valid() && name->get_source_code() == "GDCLASS"
+			&& arguments.is_valid() && arguments->get_named_child_count() == 0;
+	}
+	else {
+		return false;
+	}
+}
+
+// Returns the metadata key if node is `<table_name>.key` or `<table_name>["key"]`
+static bool read_index_key(const Ref<LuaASTNode>& node, const String& table_name, String& r_key, bool& r_is_static) {
+	String type = node->get_type();
+	if (type != "dot_index_expression" && type != "bracket_index_expression") {
+		return false;
+	}
+	Ref<LuaASTNode> table = node->get_child_by_field_name("table");
+	if (table.is_null() || table->get_source_code() != table_name) {
+		return false;
+	}
+
+	Ref<LuaASTNode> field = node->get_child_by_field_name("field");
+	if (type == "dot_index_expression") {
+		r_key = field->get_source_code();
+		r_is_static = true;
+	}
+	else {
+		r_is_static = read_string_literal(field, r_key);
+	}
+	return true;
+}
+
+// Returns true if any assignment in the subtree may change the metadata of `table_name`
+static bool has_nested_metadata_assignment(const Ref<LuaASTNode>& node, const String& table_name) {
+	if (node->get_type() == "assignment_statement") {
+		Ref<LuaASTNode> variables = node->get_named_child(0);
+		for (uint32_t i = 0; variables.is_valid() && i < variables->get_named_child_count(); i++) {
+			Ref<LuaASTNode> variable = variables->get_named_child(i);
+			String key;
+			bool is_static;
+			if (variable->get_source_code() == table_name
+				|| (read_index_key(variable, table_name, key, is_static) && (!is_static || is_metadata_key(key))))
+			{
+				return true;
+			}
+		}
+	}
+	for (uint32_t i = 0; i < node->get_named_child_count(); i++) {
+		if (has_nested_metadata_assignment(node->get_named_child(i), table_name)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool read_top_level_assignment(const Ref<LuaASTNode>& assignment, const String& table_name, bool& r_declared, StaticClassInfo& info) {
+	Ref<LuaASTNode> variables = assignment->get_named_child(0);
+	Ref<LuaASTNode> values = assignment->get_named_child(1);
+	if (variables.is_null()) {
+		return true;
+	}
+	for (uint32_t i = 0; i < variables->get_named_child_count(); i++) {
+		Ref<LuaASTNode> variable = variables->get_named_child(i);
+		Ref<LuaASTNode> value = values.is_valid() && i < values->get_named_child_count() ? values->get_named_child(i) : Ref<LuaASTNode>();
+		String key;
+		bool is_static;
+		if (variable->get_source_code() == table_name) {
+			if (!read_class_table(value, info)) {
+				return false;
+			}
+			r_declared = true;
+		}
+		else if (read_index_key(variable, table_name, key, is_static)) {
+			if (!is_static || !read_metadata_field(key, value, info)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static bool read_chunk(const Ref<LuaASTNode>& chunk, StaticClassInfo& info) {
+	// Comments are also named nodes, so skip the ones after the return statement
+	uint32_t statement_count = chunk->get_named_child_count();
+	while (statement_count > 0 && chunk->get_named_child(statement_count - 1)->get_type() == "comment") {
+		statement_count--;
+	}
+	if (statement_count == 0) {
+		return false;
+	}
+	Ref<LuaASTNode> return_statement = chunk->get_named_child(statement_count - 1);
+	if (return_statement->get_type() != "return_statement") {
+		return false;
+	}
+	Ref<LuaASTNode> return_values = return_statement->get_named_child(0);
+	Ref<LuaASTNode> returned = return_values.is_valid() ? return_values->get_named_child(0) : Ref<LuaASTNode>();
+	if (returned.is_null()) {
+		return false;
+	}
+	if (returned->get_type() == "table_constructor") {
+		return read_class_table(returned, info);
+	}
+	if (returned->get_type() != "identifier") {
+		return false;
+	}
+
+	String table_name = returned->get_source_code();
+	bool declared = false;
+	for (uint32_t i = 0; i < statement_count - 1; i++) {
+		Ref<LuaASTNode> statement = chunk->get_named_child(i);
+		String type = statement->get_type();
+		if (type == "variable_declaration") {
+			Ref<LuaASTNode> declaration = statement->get_named_child(0);
+			if (declaration.is_valid() && declaration->get_type() == "assignment_statement") {
+				if (!read_top_level_assignment(declaration, table_name, declared, info)) {
+					return false;
+				}
+			}
+		}
+		else if (type == "assignment_statement") {
+			if (!read_top_level_assignment(statement, table_name, declared, info)) {
+				return false;
+			}
+		}
+		else if (type != "comment" && has_nested_metadata_assignment(statement, table_name)) {
+			return false;
+		}
+	}
+	return declared;
+}
+
+static bool get_class_info(const String& path, StaticClassInfo& r_info, int depth) {
+	if (depth > MAX_INHERITANCE_DEPTH || !FileAccess::file_exists(path)) {
+		return false;
+	}
+
+	// Throwaway parser, since the editor may scan files in threads
+	Ref<LuaParser> parser;
+	parser.instantiate();
+	Ref<LuaAST> ast = parser->parse_code(FileAccess::get_file_as_string(path));
+	if (ast.is_null() || ast->has_errors() || !read_chunk(ast->get_root(), r_info)) {
+		return false;
+	}
+
+	if (!r_info.base_script_path.is_empty()) {
+		String base_path = r_info.base_script_path;
+		if (base_path.begins_with("uid://")) {
+			base_path = ResourceUID::get_singleton()->get_id_path(ResourceUID::get_singleton()->text_to_id(base_path));
+		}
+		else if (base_path.is_relative_path()) {
+			base_path = path.get_base_dir().path_join(base_path);
+		}
+
+		StaticClassInfo base_info;
+		if (!get_class_info(base_path, base_info, depth + 1)) {
+			return false;
+		}
+		r_info.base_type = base_info.base_type;
+		if (r_info.icon_path.is_empty()) {
+			r_info.icon_path = base_info.icon_path;
+		}
+	}
+	return true;
+}
+
+bool LuaScriptStaticAnalyzer::get_global_class_info(const String& path, Dictionary& r_info) {
+	StaticClassInfo info;
+	if (!get_class_info(path, info, 0)) {
+		return false;
+	}
+
+	r_info.clear();
+	if (!info.class_name.is_empty()) {
+		r_info["name"] = info.class_name;
+		r_info["base_type"] = info.base_type;
+		r_info["icon_path"] = info.icon_path;
+		r_info["is_abstract"] = false;
+		r_info["is_tool"] = info.is_tool;
+	}
+	return true;
+}
+
+}
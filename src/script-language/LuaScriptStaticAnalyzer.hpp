@@ -0,0 +1,45 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LUA_SCRIPT_STATIC_ANALYZER_HPP__
+#define __LUA_SCRIPT_STATIC_ANALYZER_HPP__
+
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Extracts script metadata from Lua source code without executing it.
+ */
+class LuaScriptStaticAnalyzer {
+public:
+	// Fill `r_info` with the `class_name`, `extends`, `icon` and `tool` declared by the script at `path`,
+	// in the format expected by `ScriptLanguageExtension._get_global_class_name`.
+	// Returns false if the metadata cannot be resolved statically, like when values are computed at runtime.
+	static bool get_global_class_info(const String& path, Dictionary& r_info);
+};
+
+}
+
+#endif  // __LUA_SCRIPT_STATIC_ANALYZER_HPP__
@@ -0,0 +1,203 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaAllocationProfiler.hpp"
+
+#include "LuaAllocator.hpp"
+
+namespace luagdextension {
+
+LuaAllocationProfiler::RunningThreadScope::RunningThreadScope(lua_State *L)
+	: previous(running_thread)
+{
+	running_thread = L;
+}
+
+LuaAllocationProfiler::RunningThreadScope::~RunningThreadScope() {
+	running_thread = previous;
+}
+
+LuaAllocationProfiler::LuaAllocationProfiler(lua_State *main_thread, void *allocator, uint64_t sample_interval)
+	: main_thread(main_thread)
+	, allocator(allocator)
+	, sample_interval(MAX(sample_interval, 1))
+{
+}
+
+void LuaAllocationProfiler::restart(uint64_t sample_interval) {
+	this->sample_interval = MAX(sample_interval, 1);
+	bytes_since_sample = 0;
+	frames.clear();
+	stacks.clear();
+	stack_indices.clear();
+	sampled_blocks.clear();
+	pending_blocks.clear();
+	pending_bytes = 0;
+	pending_samples = 0;
+}
+
+void LuaAllocationProfiler::on_allocate(const void *ptr, size_t size) {
+	bytes_since_sample += size;
+	if (bytes_since_sample < sample_interval) {
+		return;
+	}
+
+	sampled_blocks.insert(ptr, { PENDING_STACK, bytes_since_sample });
+	pending_blocks.push_back(ptr);
+	pending_bytes += bytes_since_sample;
+	pending_samples++;
+	bytes_since_sample = 0;
+	arm_capture_hook(get_running_thread());
+}
+
+void LuaAllocationProfiler::on_free(const void *ptr) {
+	if (sampled_blocks.is_empty()) {
+		return;
+	}
+	if (const SampledBlock *block = sampled_blocks.getptr(ptr)) {
+		// Pending blocks only count as allocated bytes once their stack is captured
+		if (block->stack_index != PENDING_STACK) {
+			stacks[block->stack_index].live_bytes -= block->bytes;
+		}
+		sampled_blocks.erase(ptr);
+	}
+}
+
+uint64_t LuaAllocationProfiler::get_sample_interval() const {
+	return sample_interval;
+}
+
+Dictionary LuaAllocationProfiler::get_locations() const {
+	Dictionary locations;
+	for (const Stack& stack : stacks) {
+		String key = get_location(stack.frames);
+		Dictionary location = locations.get(key, Dictionary());
+		location["total_bytes"] = (uint64_t) location.get("total_bytes", 0) + stack.total_bytes;
+		location["live_bytes"] = (uint64_t) location.get("live_bytes", 0) + stack.live_bytes;
+		location["samples"] = (uint64_t) location.get("samples", 0) + stack.samples;
+		locations[key] = location;
+	}
+	return locations;
+}
+
+String LuaAllocationProfiler::get_folded_stacks(bool live_only) const {
+	PackedStringArray lines;
+	for (const Stack& stack : stacks) {
+		uint64_t bytes = live_only ? stack.live_bytes : stack.total_bytes;
+		if (bytes > 0) {
+			lines.append(frames.get_folded_stack(stack.frames) + " " + String::num_uint64(bytes));
+		}
+	}
+	return String("\n").join(lines);
+}
+
+lua_State *LuaAllocationProfiler::get_running_thread() const {
+	// Godot may be resuming coroutines from another Lua state
+	void *running_thread_allocator = nullptr;
+	if (running_thread) {
+		lua_getallocf(running_thread, &running_thread_allocator);
+	}
+	return running_thread_allocator == allocator ? running_thread : main_thread;
+}
+
+uint32_t LuaAllocationProfiler::capture_stack(lua_State *L) {
+	frames.capture_stack(L, true, captured_frames);
+	if (const uint32_t *index = stack_indices.getptr(captured_frames)) {
+		return *index;
+	}
+	uint32_t index = stacks.size();
+	Stack stack;
+	stack.frames = captured_frames;
+	stacks.push_back(stack);
+	stack_indices.insert(captured_frames, index);
+	return index;
+}
+
+String LuaAllocationProfiler::get_location(const LocalVector<uint32_t>& stack) const {
+	// Innermost frame with line information, skipping C functions
+	for (int64_t i = (int64_t) stack.size() - 1; i >= 0; i--) {
+		const LuaStackFrames::Frame& frame = frames.get_frames()[stack[i]];
+		if (frame.line >= 0) {
+			return String("%s:%d") % Array::make(frame.file, frame.line);
+		}
+	}
+	return frames.get_folded_stack(stack);
+}
+
+void LuaAllocationProfiler::arm_capture_hook(lua_State *L) {
+	// Setting hooks only touches the thread's hook fields, so it is safe from within the allocator
+	lua_Hook current_hook = lua_gethook(L);
+	if (current_hook == capture_hookf) {
+		return;
+	}
+	Hook replaced { current_hook, lua_gethookmask(L), lua_gethookcount(L) };
+	replaced_hooks.insert(L, replaced);
+	lua_sethook(L, capture_hookf, replaced.mask | LUA_MASKCOUNT, 1);
+}
+
+void LuaAllocationProfiler::capture_pending_samples(lua_State *L) {
+	if (pending_samples == 0) {
+		return;
+	}
+	uint32_t stack_index = capture_stack(L);
+	Stack& stack = stacks[stack_index];
+	stack.total_bytes += pending_bytes;
+	stack.samples += pending_samples;
+	for (const void *ptr : pending_blocks) {
+		// Blocks freed before the capture are not live anymore
+		SampledBlock *block = sampled_blocks.getptr(ptr);
+		if (block && block->stack_index == PENDING_STACK) {
+			block->stack_index = stack_index;
+			stack.live_bytes += block->bytes;
+		}
+	}
+	pending_blocks.clear();
+	pending_bytes = 0;
+	pending_samples = 0;
+}
+
+void LuaAllocationProfiler::capture_hookf(lua_State *L, lua_Debug *ar) {
+	void *allocator = nullptr;
+	lua_getallocf(L, &allocator);
+	LuaAllocationProfiler *profiler = ((LuaAllocator *) allocator)->get_profiler();
+
+	Hook replaced;
+	if (const Hook *hook = profiler->replaced_hooks.getptr(L)) {
+		replaced = *hook;
+		profiler->replaced_hooks.erase(L);
+	}
+	else if (L != profiler->main_thread && lua_gethook(profiler->main_thread) != capture_hookf) {
+		// Coroutines created while the hook was armed inherited it, so restore the hook they would inherit instead
+		replaced = { lua_gethook(profiler->main_thread), lua_gethookmask(profiler->main_thread), lua_gethookcount(profiler->main_thread) };
+	}
+	lua_sethook(L, replaced.func, replaced.mask, replaced.count);
+
+	profiler->capture_pending_samples(L);
+
+	int event_mask = ar->event == LUA_HOOKTAILCALL ? LUA_MASKCALL : (1 << ar->event);
+	if (replaced.func && (replaced.mask & event_mask)) {
+		replaced.func(L, ar);
+	}
+}
+
+thread_local lua_State *LuaAllocationProfiler::running_thread = nullptr;
+
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_LUA_ALLOCATION_PROFILER_HPP__
+#define __UTILS_LUA_ALLOCATION_PROFILER_HPP__
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include "LuaStackFrames.hpp"
+
+#include <lua.h>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Samples allocations made by a Lua state and attributes them to the Lua call stack that made them.
+ *
+ * One allocation is sampled every time `sample_interval` bytes are allocated, and it accounts for all bytes allocated since the previous sample.
+ * Sampled blocks are tracked until freed, so that live bytes can be reported as well.
+ *
+ * The call stack is never inspected from the allocator, since Lua may be in the middle of reallocating its own stack.
+ * Instead, samples are kept pending and a one-shot hook captures the stack on the next hook event of the sampled thread,
+ * forwarding events to the hook it replaced.
+ */
+class LuaAllocationProfiler {
+public:
+	// Coroutines resumed from Godot, used for capturing the right call stack.
+	// Coroutines resumed by `coroutine.resume` are attributed to the stack that resumed them.
+	struct RunningThreadScope {
+		RunningThreadScope(lua_State *L);
+		~RunningThreadScope();
+
+	private:
+		lua_State *previous;
+	};
+
+	LuaAllocationProfiler(lua_State *main_thread, void *allocator, uint64_t sample_interval);
+
+	// Clears collected data, keeping hooks that are still waiting to capture a stack
+	void restart(uint64_t sample_interval);
+
+	void on_allocate(const void *ptr, size_t size);
+	void on_free(const void *ptr);
+
+	uint64_t get_sample_interval() const;
+	Dictionary get_locations() const;
+	String get_folded_stacks(bool live_only) const;
+
+private:
+	lua_State *get_running_thread() const;
+	uint32_t capture_stack(lua_State *L);
+	void arm_capture_hook(lua_State *L);
+	void capture_pending_samples(lua_State *L);
+	static void capture_hookf(lua_State *L, lua_Debug *ar);
+
+	String get_location(const LocalVector<uint32_t>& stack) const;
+
+	struct Stack {
+		// From the outermost frame to the innermost one, identified by their current line
+		LocalVector<uint32_t> frames;
+		uint64_t total_bytes = 0;
+		uint64_t live_bytes = 0;
+		uint64_t samples = 0;
+	};
+	// Stack index of sampled blocks whose stack was not captured yet
+	static constexpr uint32_t PENDING_STACK = UINT32_MAX;
+	struct SampledBlock {
+		uint32_t stack_index;
+		uint64_t bytes;
+	};
+	struct Hook {
+		lua_Hook func = nullptr;
+		int mask = 0;
+		int count = 0;
+	};
+
+	lua_State *main_thread;
+	void *allocator;
+	uint64_t sample_interval;
+	uint64_t bytes_since_sample = 0;
+	LuaStackFrames frames;
+	LocalVector<Stack> stacks;
+	HashMap<LocalVector<uint32_t>, uint32_t, LuaStackHasher, LuaStackComparator> stack_indices;
+	LocalVector<uint32_t> captured_frames;
+	HashMap<const void *, SampledBlock> sampled_blocks;
+	LocalVector<const void *> pending_blocks;
+	uint64_t pending_bytes = 0;
+	uint64_t pending_samples = 0;
+	// Hooks replaced by the capture hook, restored after capturing
+	HashMap<lua_State *, Hook> replaced_hooks;
+
+	static thread_local lua_State *running_thread;
+};
+
+}
+
+#endif  // __UTILS_LUA_ALLOCATION_PROFILER_HPP__
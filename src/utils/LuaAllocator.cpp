@@ -0,0 +1,318 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaAllocator.hpp"
+
+#include "allocation_counters.hpp"
+
+#include <godot_cpp/core/memory.hpp>
+
+#include <cstring>
+
+namespace luagdextension {
+
+LuaAllocator::LuaAllocator(Mode mode, lua_Alloc backing_alloc, void *backing_ud)
+	: mode(mode)
+	, backing_alloc(backing_alloc)
+	, backing_ud(backing_ud)
+{
+}
+
+LuaAllocator::~LuaAllocator() {
+	// Lua frees every block when the state is closed, so slabs can be released as a whole
+	for (void *slab : slabs) {
+		_backing_reallocate(slab, SLAB_SIZE, 0);
+	}
+}
+
+LuaAllocator::Mode LuaAllocator::get_mode() const {
+	return mode;
+}
+
+void LuaAllocator::track_existing_bytes(size_t bytes) {
+	bytes_in_use += bytes;
+	if (bytes_in_use > peak_bytes_in_use) {
+		peak_bytes_in_use = bytes_in_use;
+	}
+}
+
+uint64_t LuaAllocator::get_bytes_in_use() const {
+	return bytes_in_use;
+}
+
+uint64_t LuaAllocator::get_peak_bytes_in_use() const {
+	return peak_bytes_in_use;
+}
+
+void LuaAllocator::reset_peak_bytes_in_use() {
+	peak_bytes_in_use = bytes_in_use;
+}
+
+size_t LuaAllocator::get_memory_limit() const {
+	return memory_limit;
+}
+
+void LuaAllocator::set_memory_limit(size_t limit) {
+	memory_limit = limit;
+}
+
+size_t LuaAllocator::get_memory_soft_limit() const {
+	return memory_soft_limit;
+}
+
+void LuaAllocator::set_memory_soft_limit(size_t limit) {
+	memory_soft_limit = limit;
+}
+
+void LuaAllocator::set_soft_limit_callback(SoftLimitCallback callback, void *userdata) {
+	soft_limit_callback = callback;
+	soft_limit_userdata = userdata;
+}
+
+void LuaAllocator::clear_soft_limit_pending() {
+	soft_limit_pending = false;
+}
+
+void LuaAllocator::start_profiling(lua_State *main_thread, uint64_t sample_interval) {
+	// Threads may still have hooks from the previous run waiting to capture a stack, so keep the same profiler
+	if (profiler) {
+		profiler->restart(sample_interval);
+	}
+	else {
+		profiler = std::make_unique<LuaAllocationProfiler>(main_thread, this, sample_interval);
+	}
+	profiling = true;
+}
+
+void LuaAllocator::stop_profiling() {
+	profiling = false;
+}
+
+bool LuaAllocator::is_profiling() const {
+	return profiling;
+}
+
+const LuaAllocationProfiler *LuaAllocator::get_profiler() const {
+	return profiler.get();
+}
+
+LuaAllocationProfiler *LuaAllocator::get_profiler() {
+	return profiler.get();
+}
+
+Dictionary LuaAllocator::get_statistics() const {
+	Dictionary statistics;
+	statistics["bytes_in_use"] = bytes_in_use;
+	statistics["peak_bytes_in_use"] = peak_bytes_in_use;
+	statistics["failed_allocations"] = failed_allocation_count;
+	statistics["small_allocations"] = small_allocation_count;
+	statistics["backing_allocations"] = backing_allocation_count;
+	statistics["slab_count"] = slabs.size();
+	statistics["slab_bytes"] = (uint64_t) slabs.size() * SLAB_SIZE;
+	return statistics;
+}
+
+void *LuaAllocator::alloc(void *ud, void *ptr, size_t osize, size_t nsize) {
+	return ((LuaAllocator *) ud)->_reallocate(ptr, osize, nsize);
+}
+
+int LuaAllocator::get_size_class(size_t size) {
+	if (size <= 256) {
+		// 16 byte steps: 16, 32, ..., 256
+		return (int) ((size + 15) / 16) - 1;
+	}
+	else if (size <= MAX_SMALL_SIZE) {
+		// 64 byte steps: 320, 384, 448, 512
+		return 16 + (int) ((size - 257) / 64);
+	}
+	else {
+		return -1;
+	}
+}
+
+size_t LuaAllocator::get_size_class_size(int size_class) {
+	return size_class < 16
+		? (size_t) (size_class + 1) * 16
+		: 256 + (size_t) (size_class - 15) * 64;
+}
+
+void *LuaAllocator::_reallocate(void *ptr, size_t osize, size_t nsize) {
+	// When allocating new blocks, Lua passes the object type in `osize`
+	if (ptr == nullptr) {
+		osize = 0;
+	}
+
+	// Returning NULL makes Lua raise a memory error, frees must always succeed
+	if (memory_limit > 0 && nsize > osize && bytes_in_use + (nsize - osize) > memory_limit) {
+		failed_allocation_count++;
+		return nullptr;
+	}
+
+	void *result = mode == MODE_POOL
+		? _pool_reallocate(ptr, osize, nsize)
+		: _backing_reallocate(ptr, osize, nsize);
+	if (result == nullptr && ptr != nullptr && nsize > 0 && nsize <= osize) {
+		// Lua assumes shrinking never fails, keeping the bigger block is fine for the backing allocator.
+		// Pool blocks are never shrunk here, `_pool_reallocate` already keeps them in place.
+		result = ptr;
+	}
+	if (result == nullptr && nsize > 0) {
+		failed_allocation_count++;
+		return nullptr;
+	}
+
+	if (profiling) {
+		// Blocks grown in place are sampled again as new allocations
+		if (ptr != nullptr && (result != ptr || nsize > osize)) {
+			profiler->on_free(ptr);
+		}
+		if (nsize > osize) {
+			profiler->on_allocate(result, nsize - osize);
+		}
+	}
+
+	if (nsize > osize) {
+		count_lua_allocation(nsize - osize);
+	}
+
+	uint64_t previous_bytes_in_use = bytes_in_use;
+	bytes_in_use = bytes_in_use + nsize - osize;
+	if (bytes_in_use > peak_bytes_in_use) {
+		peak_bytes_in_use = bytes_in_use;
+	}
+	if (memory_soft_limit > 0 && previous_bytes_in_use <= memory_soft_limit && bytes_in_use > memory_soft_limit && !soft_limit_pending && soft_limit_callback) {
+		soft_limit_pending = true;
+		soft_limit_callback(soft_limit_userdata);
+	}
+	return result;
+}
+
+void *LuaAllocator::_pool_reallocate(void *ptr, size_t osize, size_t nsize) {
+	int old_class = ptr != nullptr ? get_size_class(osize) : -1;
+	int new_class = nsize > 0 ? get_size_class(nsize) : -1;
+	// Backing blocks shrunk in place have a small size, but must still go back to the backing allocator
+	bool is_shrunk_backing_block = old_class >= 0 && !shrunk_backing_blocks.is_empty() && shrunk_backing_blocks.has(ptr);
+	if (is_shrunk_backing_block) {
+		old_class = -1;
+	}
+	if (nsize == 0) {
+		if (is_shrunk_backing_block) {
+			shrunk_backing_blocks.erase(ptr);
+		}
+		if (old_class >= 0) {
+			_small_free(ptr, old_class);
+		}
+		else if (ptr != nullptr) {
+			_backing_reallocate(ptr, osize, 0);
+		}
+		return nullptr;
+	}
+	else if (ptr != nullptr && old_class >= 0 && old_class == new_class) {
+		// Block is already big enough
+		return ptr;
+	}
+	else if (ptr != nullptr && old_class < 0 && new_class < 0) {
+		void *result = _backing_reallocate(ptr, osize, nsize);
+		if (result != nullptr && is_shrunk_backing_block) {
+			shrunk_backing_blocks.erase(ptr);
+		}
+		return result;
+	}
+	else {
+		// Moving between a size class and another or to/from the backing allocator
+		void *result = new_class >= 0 ? _small_allocate(new_class) : _backing_reallocate(nullptr, 0, nsize);
+		if (result == nullptr) {
+			if (ptr == nullptr || nsize > osize) {
+				// Lua expects the old block to be untouched on failures
+				return nullptr;
+			}
+			// Lua assumes shrinking never fails, so the block is kept in place.
+			// Blocks from smaller size classes are freed to their new size class, which is fine since they are big enough for it.
+			if (old_class < 0 && new_class >= 0) {
+				shrunk_backing_blocks.insert(ptr);
+			}
+			return ptr;
+		}
+		if (is_shrunk_backing_block) {
+			shrunk_backing_blocks.erase(ptr);
+		}
+		if (ptr != nullptr) {
+			memcpy(result, ptr, MIN(osize, nsize));
+			if (old_class >= 0) {
+				_small_free(ptr, old_class);
+			}
+			else {
+				_backing_reallocate(ptr, osize, 0);
+			}
+		}
+		return result;
+	}
+}
+
+void *LuaAllocator::_small_allocate(int size_class) {
+	small_allocation_count++;
+	if (FreeBlock *block = free_lists[size_class]) {
+		free_lists[size_class] = block->next;
+		return block;
+	}
+
+	size_t size = get_size_class_size(size_class);
+	if (slab_cursor == nullptr || (size_t) (slab_end - slab_cursor) < size) {
+		// The remainder of the previous slab is small and simply left unused
+		uint8_t *slab = (uint8_t *) _backing_reallocate(nullptr, 0, SLAB_SIZE);
+		if (slab == nullptr) {
+			return nullptr;
+		}
+		slabs.push_back(slab);
+		slab_cursor = slab;
+		slab_end = slab + SLAB_SIZE;
+	}
+	void *block = slab_cursor;
+	slab_cursor += size;
+	return block;
+}
+
+void LuaAllocator::_small_free(void *ptr, int size_class) {
+	FreeBlock *block = (FreeBlock *) ptr;
+	block->next = free_lists[size_class];
+	free_lists[size_class] = block;
+}
+
+void *LuaAllocator::_backing_reallocate(void *ptr, size_t osize, size_t nsize) {
+	if (nsize > 0) {
+		backing_allocation_count++;
+	}
+	LuaBackingAllocationScope backing_allocation_scope;
+	if (backing_alloc) {
+		return backing_alloc(backing_ud, ptr, osize, nsize);
+	}
+	else if (nsize == 0) {
+		if (ptr != nullptr) {
+			memfree(ptr);
+		}
+		return nullptr;
+	}
+	else {
+		return memrealloc(ptr, nsize);
+	}
+}
+
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_LUA_ALLOCATOR_HPP__
+#define __UTILS_LUA_ALLOCATOR_HPP__
+
+#include "LuaAllocationProfiler.hpp"
+
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <lua.h>
+
+#include <memory>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Memory allocator for Lua states.
+ *
+ * In pool mode, small blocks are served from per-size-class free lists carved out of big slabs,
+ * avoiding a trip to the system allocator for every tiny string, table and closure.
+ * Bigger blocks, as well as every block in default mode, go to the backing allocator.
+ *
+ * Allocations that would grow memory usage past the memory limit fail, making Lua raise a memory error.
+ * Crossing the soft limit calls the soft limit callback, which must not call into Lua, since it may run in the middle of a garbage collection step.
+ */
+class LuaAllocator {
+public:
+	enum Mode {
+		MODE_DEFAULT,
+		MODE_POOL,
+	};
+
+	// Blocks up to this size are pooled
+	static constexpr size_t MAX_SMALL_SIZE = 512;
+	static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+	using SoftLimitCallback = void (*)(void *userdata);
+
+	// Uses Godot's memory functions if no backing allocator is passed
+	LuaAllocator(Mode mode, lua_Alloc backing_alloc = nullptr, void *backing_ud = nullptr);
+	~LuaAllocator();
+
+	Mode get_mode() const;
+	// Accounts for blocks allocated before this allocator was installed
+	void track_existing_bytes(size_t bytes);
+	Dictionary get_statistics() const;
+
+	uint64_t get_bytes_in_use() const;
+	uint64_t get_peak_bytes_in_use() const;
+	void reset_peak_bytes_in_use();
+
+	// Zero means no limit
+	size_t get_memory_limit() const;
+	void set_memory_limit(size_t limit);
+	size_t get_memory_soft_limit() const;
+	void set_memory_soft_limit(size_t limit);
+	// The callback is not called again until `clear_soft_limit_pending` is called
+	void set_soft_limit_callback(SoftLimitCallback callback, void *userdata);
+	void clear_soft_limit_pending();
+
+	// Profiling data is kept after stopping, until profiling starts again
+	void start_profiling(lua_State *main_thread, uint64_t sample_interval);
+	void stop_profiling();
+	bool is_profiling() const;
+	const LuaAllocationProfiler *get_profiler() const;
+	LuaAllocationProfiler *get_profiler();
+
+	// `lua_Alloc` compatible callback, `ud` must be a LuaAllocator
+	static void *alloc(void *ud, void *ptr, size_t osize, size_t nsize);
+
+private:
+	static constexpr int SIZE_CLASS_COUNT = 20;
+	static int get_size_class(size_t size);
+	static size_t get_size_class_size(int size_class);
+
+	void *_reallocate(void *ptr, size_t osize, size_t nsize);
+	void *_pool_reallocate(void *ptr, size_t osize, size_t nsize);
+	void *_small_allocate(int size_class);
+	void _small_free(void *ptr, int size_class);
+	void *_backing_reallocate(void *ptr, size_t osize, size_t nsize);
+
+	Mode mode;
+	lua_Alloc backing_alloc;
+	void *backing_ud;
+
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+	FreeBlock *free_lists[SIZE_CLASS_COUNT] = {};
+	uint8_t *slab_cursor = nullptr;
+	uint8_t *slab_end = nullptr;
+	LocalVector<void *> slabs;
+	// Backing blocks kept in place when shrinking to a size class failed
+	HashSet<void *> shrunk_backing_blocks;
+
+	uint64_t small_allocation_count = 0;
+	uint64_t backing_allocation_count = 0;
+	uint64_t failed_allocation_count = 0;
+	uint64_t bytes_in_use = 0;
+	uint64_t peak_bytes_in_use = 0;
+
+	size_t memory_limit = 0;
+	size_t memory_soft_limit = 0;
+	SoftLimitCallback soft_limit_callback = nullptr;
+	void *soft_limit_userdata = nullptr;
+	bool soft_limit_pending = false;
+
+	std::unique_ptr<LuaAllocationProfiler> profiler;
+	bool profiling = false;
+};
+
+}
+
+#endif  // __UTILS_LUA_ALLOCATOR_HPP__
@@ -63,4 +63,17 @@ void LuaCoroutinePool::release(const sol::thread& coroutine) {
 	}
 }
 
+void LuaCoroutinePool::clear() {
+	lua_pushnil(L);
+	lua_setfield(L, LUA_REGISTRYINDEX, COROUTINE_POOL_KEY);
+}
+
+int64_t LuaCoroutinePool::get_size() const {
+	StackTopChecker topcheck(L);
+	luaL_getsubtable(L, LUA_REGISTRYINDEX, COROUTINE_POOL_KEY);
+	int64_t size = luaL_len(L, -1);
+	lua_pop(L, 1);
+	return size;
+}
+
 }
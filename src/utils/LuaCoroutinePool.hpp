@@ -31,6 +31,9 @@ struct LuaCoroutinePool {
 
 	sol::thread acquire(const sol::function& f);
 	void release(const sol::thread& coroutine);
+	int64_t get_size() const;
+	// Drops all pooled coroutines, letting them be collected
+	void clear();
 
 private:
 	sol::state_view L;
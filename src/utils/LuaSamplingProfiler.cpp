@@ -0,0 +1,140 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaSamplingProfiler.hpp"
+
+#include <godot_cpp/classes/json.hpp>
+
+namespace luagdextension {
+
+void LuaSamplingProfiler::sample(lua_State *L) {
+	MutexLock lock(mutex);
+	frames.capture_stack(L, false, sampled_frames);
+	sample_count++;
+	if (const uint32_t *index = stack_indices.getptr(sampled_frames)) {
+		stacks[*index].samples++;
+		return;
+	}
+	Stack stack;
+	stack.frames = sampled_frames;
+	stack.samples = 1;
+	stack_indices.insert(sampled_frames, stacks.size());
+	stacks.push_back(stack);
+}
+
+void LuaSamplingProfiler::start_thread(lua_State *L) {
+	MutexLock lock(mutex);
+	sampling_threads.insert(L);
+	running.store(true, std::memory_order_relaxed);
+}
+
+void LuaSamplingProfiler::stop_thread(lua_State *L) {
+	MutexLock lock(mutex);
+	sampling_threads.erase(L);
+	running.store(!sampling_threads.is_empty(), std::memory_order_relaxed);
+}
+
+void LuaSamplingProfiler::stop_all_threads() {
+	MutexLock lock(mutex);
+	sampling_threads.clear();
+	running.store(false, std::memory_order_relaxed);
+}
+
+void LuaSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	sample_count = 0;
+	frames.clear();
+	stacks.clear();
+	stack_indices.clear();
+}
+
+uint64_t LuaSamplingProfiler::get_sample_count() const {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+Dictionary LuaSamplingProfiler::get_stacks() const {
+	MutexLock lock(mutex);
+	Dictionary result;
+	for (const Stack& stack : stacks) {
+		// Different C functions may fold to the same text
+		String folded = frames.get_folded_stack(stack.frames);
+		result[folded] = (uint64_t) result.get(folded, 0) + stack.samples;
+	}
+	return result;
+}
+
+String LuaSamplingProfiler::get_folded_stacks() const {
+	MutexLock lock(mutex);
+	PackedStringArray lines;
+	for (const Stack& stack : stacks) {
+		lines.append(frames.get_folded_stack(stack.frames) + " " + String::num_uint64(stack.samples));
+	}
+	return String("\n").join(lines);
+}
+
+String LuaSamplingProfiler::get_speedscope_json(const String& profile_name) const {
+	// https://www.speedscope.app/file-format-schema.json
+	MutexLock lock(mutex);
+	Array shared_frames;
+	for (const LuaStackFrames::Frame& frame : frames.get_frames()) {
+		Dictionary shared_frame;
+		shared_frame["name"] = frame.name;
+		shared_frame["file"] = frame.file;
+		if (frame.line > 0) {
+			shared_frame["line"] = frame.line;
+		}
+		shared_frames.append(shared_frame);
+	}
+
+	Array samples;
+	Array weights;
+	for (const Stack& stack : stacks) {
+		Array sample;
+		for (uint32_t frame_index : stack.frames) {
+			sample.append(frame_index);
+		}
+		samples.append(sample);
+		weights.append(stack.samples);
+	}
+
+	Dictionary profile;
+	profile["type"] = "sampled";
+	profile["name"] = profile_name;
+	profile["unit"] = "none";
+	profile["startValue"] = 0;
+	profile["endValue"] = sample_count;
+	profile["samples"] = samples;
+	profile["weights"] = weights;
+
+	Dictionary shared;
+	shared["frames"] = shared_frames;
+
+	Dictionary root;
+	root["$schema"] = "https://www.speedscope.app/file-format-schema.json";
+	root["shared"] = shared;
+	root["profiles"] = Array::make(profile);
+	root["name"] = profile_name;
+	root["exporter"] = "Lua GDExtension";
+	return JSON::stringify(root, "", false);
+}
+
+}
@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_LUA_SAMPLING_PROFILER_HPP__
+#define __UTILS_LUA_SAMPLING_PROFILER_HPP__
+
+#include <godot_cpp/core/mutex.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include "LuaStackFrames.hpp"
+
+#include <lua.h>
+
+#include <atomic>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Collects Lua call stacks sampled by count hooks, shared by all threads of a Lua state.
+ *
+ * Frames are identified by source and the line where their function was defined, so that samples taken anywhere inside the same function are merged.
+ */
+class LuaSamplingProfiler {
+public:
+	void sample(lua_State *L);
+	void clear();
+
+	// Threads that started sampling and were not stopped yet.
+	// Hooks inherited by coroutines, including pooled ones, remove themselves when no thread is sampling.
+	void start_thread(lua_State *L);
+	void stop_thread(lua_State *L);
+	void stop_all_threads();
+	bool is_running() const {
+		return running.load(std::memory_order_relaxed);
+	}
+
+	uint64_t get_sample_count() const;
+	Dictionary get_stacks() const;
+	String get_folded_stacks() const;
+	String get_speedscope_json(const String& profile_name) const;
+
+private:
+	struct Stack {
+		// From the outermost frame to the innermost one
+		LocalVector<uint32_t> frames;
+		uint64_t samples = 0;
+	};
+
+	mutable Mutex mutex;
+	HashSet<lua_State *> sampling_threads;
+	std::atomic<bool> running = false;
+	uint64_t sample_count = 0;
+	LuaStackFrames frames;
+	LocalVector<Stack> stacks;
+	HashMap<LocalVector<uint32_t>, uint32_t, LuaStackHasher, LuaStackComparator> stack_indices;
+	// Reused between samples to avoid allocations
+	LocalVector<uint32_t> sampled_frames;
+};
+
+}
+
+#endif  // __UTILS_LUA_SAMPLING_PROFILER_HPP__
@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LuaStackFrames.hpp"
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+
+namespace luagdextension {
+
+void LuaStackFrames::capture_stack(lua_State *L, bool use_current_line, LocalVector<uint32_t>& r_frames) {
+	// Only reads debug information, since the state may be in the middle of any operation
+	r_frames.clear();
+	lua_Debug ar;
+	for (int level = 0; level < MAX_STACK_DEPTH && lua_getstack(L, level, &ar); level++) {
+		r_frames.push_back(get_frame_index(L, ar, use_current_line));
+	}
+	r_frames.invert();
+}
+
+void LuaStackFrames::clear() {
+	frames.clear();
+	frame_indices.clear();
+}
+
+String LuaStackFrames::get_folded_frame(uint32_t frame_index) const {
+	const Frame& frame = frames[frame_index];
+	return String("%s:%d (%s)") % Array::make(frame.file, frame.line, frame.name);
+}
+
+String LuaStackFrames::get_folded_stack(const LocalVector<uint32_t>& stack) const {
+	if (stack.is_empty()) {
+		return "[no Lua stack]";
+	}
+	PackedStringArray folded;
+	for (uint32_t frame_index : stack) {
+		folded.append(get_folded_frame(frame_index));
+	}
+	return String(";").join(folded);
+}
+
+uint32_t LuaStackFrames::get_frame_index(lua_State *L, lua_Debug& ar, bool use_current_line) {
+	lua_getinfo(L, "Slf", &ar);
+	// All C functions share the same source string, so they are told apart by their function pointer
+	lua_CFunction cfunction = lua_tocfunction(L, -1);
+	lua_pop(L, 1);
+	int line = use_current_line ? ar.currentline : ar.linedefined;
+	FrameKey key { cfunction ? (const void *) cfunction : (const void *) ar.source, line };
+	if (const uint32_t *index = frame_indices.getptr(key)) {
+		return *index;
+	}
+
+	lua_getinfo(L, "n", &ar);
+	String name = ar.name ? String::utf8(ar.name) : (ar.what[0] == 'm' ? String("main chunk") : String("?"));
+	uint32_t index = frames.size();
+	frames.push_back({ name, String::utf8(ar.short_src), line });
+	frame_indices.insert(key, index);
+	return index;
+}
+
+}
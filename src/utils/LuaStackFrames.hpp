@@ -0,0 +1,110 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_LUA_STACK_FRAMES_HPP__
+#define __UTILS_LUA_STACK_FRAMES_HPP__
+
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hashfuncs.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+#include <lua.h>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Call stack frames captured by profilers, shared by the sampling and allocation profilers.
+ *
+ * Frames are identified by their source pointer and line, so that capturing a stack doesn't build any String.
+ * Names are only formatted when a frame is seen for the first time, and folded stacks only when exporting results.
+ */
+class LuaStackFrames {
+public:
+	// Maximum number of frames captured per stack, starting from the innermost one
+	static constexpr int MAX_STACK_DEPTH = 64;
+
+	struct Frame {
+		String name;
+		String file;
+		int line;
+	};
+
+	// Fills `r_frames` with the frame indices of `L`'s call stack, from the outermost frame to the innermost one.
+	// Frames are identified by the line where their function was defined, or by their current line if `use_current_line` is true.
+	void capture_stack(lua_State *L, bool use_current_line, LocalVector<uint32_t>& r_frames);
+	void clear();
+
+	const LocalVector<Frame>& get_frames() const {
+		return frames;
+	}
+	String get_folded_frame(uint32_t frame_index) const;
+	// Returns "[no Lua stack]" for empty stacks
+	String get_folded_stack(const LocalVector<uint32_t>& stack) const;
+
+private:
+	uint32_t get_frame_index(lua_State *L, lua_Debug& ar, bool use_current_line);
+
+	struct FrameKey {
+		// Chunk source string for Lua functions, function pointer for C functions
+		const void *source;
+		int line;
+	};
+	struct FrameKeyHasher {
+		static uint32_t hash(const FrameKey& key) {
+			return hash_fmix32(hash_murmur3_one_64((uint64_t) (uintptr_t) key.source, hash_murmur3_one_32(key.line)));
+		}
+	};
+	struct FrameKeyComparator {
+		static bool compare(const FrameKey& a, const FrameKey& b) {
+			return a.source == b.source && a.line == b.line;
+		}
+	};
+
+	LocalVector<Frame> frames;
+	HashMap<FrameKey, uint32_t, FrameKeyHasher, FrameKeyComparator> frame_indices;
+};
+
+// Hashes stacks by their frame indices, for keying profiler results by stack
+struct LuaStackHasher {
+	static uint32_t hash(const LocalVector<uint32_t>& stack) {
+		return hash_murmur3_buffer(stack.ptr(), stack.size() * sizeof(uint32_t));
+	}
+};
+struct LuaStackComparator {
+	static bool compare(const LocalVector<uint32_t>& a, const LocalVector<uint32_t>& b) {
+		if (a.size() != b.size()) {
+			return false;
+		}
+		for (uint32_t i = 0; i < a.size(); i++) {
+			if (a[i] != b[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+}
+
+#endif  // __UTILS_LUA_STACK_FRAMES_HPP__
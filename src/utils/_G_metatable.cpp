@@ -24,16 +24,70 @@
 #include "Class.hpp"
 #include "convert_godot_lua.hpp"
 #include "module_names.hpp"
+#include "../luaopen/godot.hpp"
 #include "../script-language/LuaScriptLanguage.hpp"
 
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
 #include <godot_cpp/classes/resource_loader.hpp>
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/core/mutex.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+
+#include <atomic>
 
 using namespace godot;
 
 namespace luagdextension {
 
+constexpr char GLOBAL_CLASS_MISSES_KEY[] = "_GDEXTENSION_GLOBAL_CLASS_MISSES";
+
+// Script global classes, shared by all Lua states.
+// Rebuilt on the first lookup after `clear_global_class_cache`, which the editor calls when script classes are updated.
+static std::atomic<uint32_t> global_class_generation = 0;
+static HashMap<StringName, String> global_class_paths;
+static uint32_t global_class_paths_generation = UINT32_MAX;
+static Mutex global_class_paths_mutex;
+
+void clear_global_class_cache() {
+	global_class_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+static String get_global_class_path(sol::state_view& state, sol::table& registry, std::string_view name) {
+	// Names that are not global classes are cached per state, so that optional globals like
+	// `if SomeGlobal then ... end` don't take the shared lock on every check
+	uint32_t generation = global_class_generation.load(std::memory_order_relaxed);
+	sol::optional<sol::table> misses = registry.raw_get<sol::optional<sol::table>>(GLOBAL_CLASS_MISSES_KEY);
+	if (!misses || misses->raw_get_or("generation", (uint32_t) UINT32_MAX) != generation) {
+		misses = state.create_table_with("generation", generation);
+		registry.raw_set(GLOBAL_CLASS_MISSES_KEY, *misses);
+	}
+	if (misses->raw_get_or(name, false)) {
+		return String();
+	}
+
+	String path;
+	{
+		MutexLock lock(global_class_paths_mutex);
+		if (global_class_paths_generation != generation) {
+			global_class_paths_generation = generation;
+			global_class_paths.clear();
+			TypedArray<Dictionary> global_class_list = ProjectSettings::get_singleton()->get_global_class_list();
+			for (int64_t i = 0; i < global_class_list.size(); ++i) {
+				Dictionary type_info = global_class_list[i];
+				global_class_paths.insert(type_info["class"], type_info["path"]);
+			}
+		}
+		if (const String *found = global_class_paths.getptr(StringName(String::utf8(name.data(), name.size())))) {
+			path = *found;
+		}
+	}
+	if (path.is_empty()) {
+		misses->raw_set(name, true);
+	}
+	return path;
+}
+
 sol::object __index(sol::this_state state, sol::global_table _G, sol::stack_object key) {
 	static Engine *engine = Engine::get_singleton();
 	static ResourceLoader *resource_loader = ResourceLoader::get_singleton();
@@ -42,7 +96,17 @@ sol::object __index(sol::this_state state, sol::global_table _G, sol::stack_obje
 		return sol::nil;
 	}
 
-	auto registry = sol::state_view(state).registry();
+	// Lazy globals come first, since they were defined directly in `_G` before
+	sol::state_view state_view(state);
+	sol::table registry = state_view.registry();
+	std::string_view name = key.as<std::string_view>();
+	if ((registry.get_or(module_names::variant, false) && define_lazy_variant_type(state, name))
+		|| (registry.get_or(module_names::utility_functions, false) && define_lazy_utility_function(state, name))
+		|| (registry.get_or(module_names::enums, false) && define_lazy_enum(state, name)))
+	{
+		return _G.raw_get<sol::object>(key);
+	}
+
 	if (registry.get_or(module_names::singleton_access, false)) {
 		auto class_name = key.as<StringName>();
 		if (engine->has_singleton(class_name)) {
@@ -59,7 +123,7 @@ sol::object __index(sol::this_state state, sol::global_table _G, sol::stack_obje
 			Class cls(class_name);
 			return _G[key] = sol::make_object(state, cls);
 		}
-		else if (const char *global_class_path = registry.get<sol::table>("_GDEXTENSION_GLOBAL_CLASS_PATHS").get_or(key, (const char *) nullptr)) {
+		else if (String global_class_path = get_global_class_path(state_view, registry, name); !global_class_path.is_empty()) {
 			Ref<Resource> res = resource_loader->load(global_class_path);
 			return _G[key] = to_lua(state, res);
 		}
@@ -28,6 +28,9 @@ namespace luagdextension {
 
 void setup_G_metatable(sol::state_view& state);
 
+// Script global classes are cached, call this when the global class list changes
+void clear_global_class_cache();
+
 }
 
 #endif  // __UTILS_G_METATABLE_HPP__
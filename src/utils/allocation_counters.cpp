@@ -0,0 +1,104 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifdef DEBUG_ENABLED
+
+#include "allocation_counters.hpp"
+
+#include <godot_cpp/godot.hpp>
+
+namespace luagdextension {
+
+std::atomic<bool> allocation_counters_enabled;
+std::atomic<uint64_t> lua_allocation_count;
+std::atomic<uint64_t> lua_allocated_bytes;
+thread_local bool is_allocating_for_lua = false;
+
+static std::atomic<uint64_t> godot_allocation_count;
+static GDExtensionInterfaceMemAlloc original_mem_alloc;
+static GDExtensionInterfaceMemRealloc original_mem_realloc;
+
+static void *counting_mem_alloc(size_t bytes) {
+	if (are_allocation_counters_enabled() && !is_allocating_for_lua) {
+		godot_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	}
+	return original_mem_alloc(bytes);
+}
+
+static void *counting_mem_realloc(void *ptr, size_t bytes) {
+	if (are_allocation_counters_enabled() && !is_allocating_for_lua) {
+		godot_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	}
+	return original_mem_realloc(ptr, bytes);
+}
+
+AllocationCounterScope::AllocationCounterScope()
+	: was_enabled(are_allocation_counters_enabled())
+	, godot_allocations_start(godot_allocation_count.load(std::memory_order_relaxed))
+	, lua_allocations_start(lua_allocation_count.load(std::memory_order_relaxed))
+	, lua_allocated_bytes_start(lua_allocated_bytes.load(std::memory_order_relaxed))
+{
+	set_allocation_counters_enabled(true);
+}
+
+AllocationCounterScope::~AllocationCounterScope() {
+	set_allocation_counters_enabled(was_enabled);
+}
+
+Dictionary AllocationCounterScope::get_counts() const {
+	Dictionary counts;
+	counts["godot_allocations"] = godot_allocation_count.load(std::memory_order_relaxed) - godot_allocations_start;
+	counts["lua_allocations"] = lua_allocation_count.load(std::memory_order_relaxed) - lua_allocations_start;
+	counts["lua_allocated_bytes"] = lua_allocated_bytes.load(std::memory_order_relaxed) - lua_allocated_bytes_start;
+	return counts;
+}
+
+void install_allocation_counters() {
+	if (original_mem_alloc) {
+		return;
+	}
+	original_mem_alloc = gdextension_interface::mem_alloc;
+	original_mem_realloc = gdextension_interface::mem_realloc;
+	gdextension_interface::mem_alloc = counting_mem_alloc;
+	gdextension_interface::mem_realloc = counting_mem_realloc;
+}
+
+void set_allocation_counters_enabled(bool enabled) {
+	allocation_counters_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void reset_allocation_counters() {
+	godot_allocation_count.store(0, std::memory_order_relaxed);
+	lua_allocation_count.store(0, std::memory_order_relaxed);
+	lua_allocated_bytes.store(0, std::memory_order_relaxed);
+}
+
+Dictionary get_allocation_counters() {
+	Dictionary counters;
+	counters["godot_allocations"] = godot_allocation_count.load(std::memory_order_relaxed);
+	counters["lua_allocations"] = lua_allocation_count.load(std::memory_order_relaxed);
+	counters["lua_allocated_bytes"] = lua_allocated_bytes.load(std::memory_order_relaxed);
+	return counters;
+}
+
+}
+
+#endif
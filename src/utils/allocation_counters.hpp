@@ -0,0 +1,118 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_ALLOCATION_COUNTERS_HPP__
+#define __UTILS_ALLOCATION_COUNTERS_HPP__
+
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+using namespace godot;
+
+namespace luagdextension {
+
+#ifdef DEBUG_ENABLED
+
+/**
+ * Counters of memory allocations, used for benchmarks and allocation budget tests.
+ *
+ * Godot allocations are counted by intercepting the memory functions used by this extension.
+ * Memory backing Lua states is only counted as Lua allocations, so that Godot allocations reflect the binding layer.
+ * Memory allocated by the engine itself, like the storage of Arrays and Strings created by engine calls, is not counted.
+ * The memory functions are intercepted once at startup in debug builds, so counters can be toggled at any time from any thread.
+ */
+extern std::atomic<bool> allocation_counters_enabled;
+extern std::atomic<uint64_t> lua_allocation_count;
+extern std::atomic<uint64_t> lua_allocated_bytes;
+extern thread_local bool is_allocating_for_lua;
+
+inline bool are_allocation_counters_enabled() {
+	return allocation_counters_enabled.load(std::memory_order_relaxed);
+}
+
+inline void count_lua_allocation(size_t bytes) {
+	if (are_allocation_counters_enabled()) {
+		lua_allocation_count.fetch_add(1, std::memory_order_relaxed);
+		lua_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+	}
+}
+
+// Marks Godot allocations made for Lua states, which are not counted as Godot allocations
+struct LuaBackingAllocationScope {
+	LuaBackingAllocationScope() : active(are_allocation_counters_enabled()) {
+		if (active) {
+			previous = is_allocating_for_lua;
+			is_allocating_for_lua = true;
+		}
+	}
+	~LuaBackingAllocationScope() {
+		if (active) {
+			is_allocating_for_lua = previous;
+		}
+	}
+
+private:
+	bool active;
+	bool previous = false;
+};
+
+// Counts allocations made while the scope is alive, enabling counters if necessary
+class AllocationCounterScope {
+public:
+	AllocationCounterScope();
+	~AllocationCounterScope();
+
+	// `{ godot_allocations, lua_allocations, lua_allocated_bytes }` since the scope was created
+	Dictionary get_counts() const;
+
+private:
+	bool was_enabled;
+	uint64_t godot_allocations_start;
+	uint64_t lua_allocations_start;
+	uint64_t lua_allocated_bytes_start;
+};
+
+// Intercepts the memory functions used by this extension, must be called before any other thread allocates memory
+void install_allocation_counters();
+void set_allocation_counters_enabled(bool enabled);
+void reset_allocation_counters();
+// `{ godot_allocations, lua_allocations, lua_allocated_bytes }`
+Dictionary get_allocation_counters();
+
+#else
+
+// Allocation counters are only available in debug builds, so that release builds don't intercept memory functions
+inline bool are_allocation_counters_enabled() {
+	return false;
+}
+
+inline void count_lua_allocation(size_t bytes) {}
+
+struct LuaBackingAllocationScope {};
+
+#endif
+
+}
+
+#endif  // __UTILS_ALLOCATION_COUNTERS_HPP__
@@ -0,0 +1,147 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "boundary_counters.hpp"
+
+#include "convert_godot_std.hpp"
+
+#include <godot_cpp/core/mutex.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace luagdextension {
+
+std::atomic<bool> boundary_counters_enabled;
+
+static const char *BOUNDARY_COUNTER_NAMES[] = {
+	"to_variant",
+	"lua_push",
+	"variant__index",
+	"VariantMethodBind.call",
+	"ClassMethodBind.call",
+	"binary_operator",
+	"LuaFunction.invoke",
+	"LuaCoroutine.invoke",
+};
+static_assert(sizeof(BOUNDARY_COUNTER_NAMES) / sizeof(BOUNDARY_COUNTER_NAMES[0]) == BOUNDARY_MAX);
+
+// Counters with a fixed set of keys don't need locking
+static std::atomic<uint64_t> type_counts[2][Variant::VARIANT_MAX];
+static std::atomic<uint64_t> operator_counts[Variant::OP_MAX];
+
+static Mutex keyed_counts_mutex;
+static HashMap<String, uint64_t> keyed_counts[BOUNDARY_MAX];
+
+void set_boundary_counters_enabled(bool enabled) {
+	boundary_counters_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void reset_boundary_counters() {
+	for (auto& counts : type_counts) {
+		for (std::atomic<uint64_t>& count : counts) {
+			count.store(0, std::memory_order_relaxed);
+		}
+	}
+	for (std::atomic<uint64_t>& count : operator_counts) {
+		count.store(0, std::memory_order_relaxed);
+	}
+	MutexLock lock(keyed_counts_mutex);
+	for (HashMap<String, uint64_t>& counts : keyed_counts) {
+		counts.clear();
+	}
+}
+
+Array get_boundary_counter_report() {
+	struct Entry {
+		BoundaryCounter counter;
+		String key;
+		uint64_t count;
+	};
+	std::vector<Entry> entries;
+	for (int counter = BOUNDARY_TO_VARIANT; counter <= BOUNDARY_LUA_PUSH; counter++) {
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			if (uint64_t count = type_counts[counter][type].load(std::memory_order_relaxed)) {
+				entries.push_back({ (BoundaryCounter) counter, Variant::get_type_name((Variant::Type) type), count });
+			}
+		}
+	}
+	for (int op = 0; op < Variant::OP_MAX; op++) {
+		if (uint64_t count = operator_counts[op].load(std::memory_order_relaxed)) {
+			entries.push_back({ BOUNDARY_BINARY_OPERATOR, get_operator_name((Variant::Operator) op), count });
+		}
+	}
+	{
+		MutexLock lock(keyed_counts_mutex);
+		for (int counter = 0; counter < BOUNDARY_MAX; counter++) {
+			for (const KeyValue<String, uint64_t>& it : keyed_counts[counter]) {
+				entries.push_back({ (BoundaryCounter) counter, it.key, it.value });
+			}
+		}
+	}
+
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+		return a.count > b.count;
+	});
+	Array report;
+	for (const Entry& entry : entries) {
+		Dictionary item;
+		item["category"] = BOUNDARY_COUNTER_NAMES[entry.counter];
+		item["key"] = entry.key;
+		item["count"] = entry.count;
+		report.append(item);
+	}
+	return report;
+}
+
+void record_boundary_type(BoundaryCounter counter, Variant::Type type) {
+	type_counts[counter - BOUNDARY_TO_VARIANT][type].fetch_add(1, std::memory_order_relaxed);
+}
+
+void record_boundary_operator(Variant::Operator op) {
+	operator_counts[op].fetch_add(1, std::memory_order_relaxed);
+}
+
+void record_boundary_key(BoundaryCounter counter, const String& key) {
+	MutexLock lock(keyed_counts_mutex);
+	keyed_counts[counter][key]++;
+}
+
+void record_boundary_function(BoundaryCounter counter, lua_State *L) {
+	lua_Debug ar;
+	lua_getinfo(L, ">S", &ar);
+	record_boundary_key(counter, String("%s:%d") % Array::make(String::utf8(ar.short_src), ar.linedefined));
+}
+
+void record_boundary_member(BoundaryCounter counter, const Variant& variant, const StringName& member) {
+	String type_name;
+	if (Object *obj = variant.get_type() == Variant::OBJECT ? variant.operator Object*() : nullptr) {
+		type_name = obj->get_class();
+	}
+	else {
+		type_name = Variant::get_type_name(variant.get_type());
+	}
+	record_boundary_key(counter, type_name + "." + String(member));
+}
+
+}
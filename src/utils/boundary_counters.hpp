@@ -0,0 +1,102 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_BOUNDARY_COUNTERS_HPP__
+#define __UTILS_BOUNDARY_COUNTERS_HPP__
+
+#include <godot_cpp/variant/array.hpp>
+#include <godot_cpp/variant/string_name.hpp>
+#include <godot_cpp/variant/variant.hpp>
+
+#include <lua.h>
+
+#include <atomic>
+
+using namespace godot;
+
+namespace luagdextension {
+
+/**
+ * Detailed counters of operations crossing the Lua <-> Godot bridge, shared by all Lua states.
+ *
+ * Counters are always compiled in, but disabled by default: while disabled, counting costs a single relaxed atomic load.
+ */
+enum BoundaryCounter {
+	BOUNDARY_TO_VARIANT,
+	BOUNDARY_LUA_PUSH,
+	BOUNDARY_VARIANT_INDEX,
+	BOUNDARY_VARIANT_METHOD_CALL,
+	BOUNDARY_CLASS_METHOD_CALL,
+	BOUNDARY_BINARY_OPERATOR,
+	BOUNDARY_LUA_FUNCTION_INVOKE,
+	BOUNDARY_LUA_COROUTINE_INVOKE,
+	BOUNDARY_MAX,
+};
+
+extern std::atomic<bool> boundary_counters_enabled;
+
+inline bool are_boundary_counters_enabled() {
+	return boundary_counters_enabled.load(std::memory_order_relaxed);
+}
+
+void set_boundary_counters_enabled(bool enabled);
+void reset_boundary_counters();
+// Array of `{ category, key, count }` Dictionaries, sorted by count in descending order
+Array get_boundary_counter_report();
+
+void record_boundary_type(BoundaryCounter counter, Variant::Type type);
+void record_boundary_operator(Variant::Operator op);
+void record_boundary_key(BoundaryCounter counter, const String& key);
+void record_boundary_member(BoundaryCounter counter, const Variant& variant, const StringName& member);
+
+inline void count_to_variant(Variant::Type type) {
+	if (are_boundary_counters_enabled()) {
+		record_boundary_type(BOUNDARY_TO_VARIANT, type);
+	}
+}
+
+inline void count_lua_push(Variant::Type type) {
+	if (are_boundary_counters_enabled()) {
+		record_boundary_type(BOUNDARY_LUA_PUSH, type);
+	}
+}
+
+inline void count_binary_operator(Variant::Operator op) {
+	if (are_boundary_counters_enabled()) {
+		record_boundary_operator(op);
+	}
+}
+
+// Pops the function on top of the stack, counting it by source location
+void record_boundary_function(BoundaryCounter counter, lua_State *L);
+
+template<typename F>
+void count_lua_invoke(BoundaryCounter counter, const F& function) {
+	if (are_boundary_counters_enabled()) {
+		lua_State *L = function.lua_state();
+		function.push(L);
+		record_boundary_function(counter, L);
+	}
+}
+
+}
+
+#endif  // __UTILS_BOUNDARY_COUNTERS_HPP__
@@ -31,10 +31,12 @@
 #include "Class.hpp"
 #include "DictionaryIterator.hpp"
 #include "VariantArguments.hpp"
+#include "boundary_counters.hpp"
 #include "convert_godot_std.hpp"
 #include "extra_utility_functions.hpp"
 #include "load_fileaccess.hpp"
 #include "method_bind_impl.hpp"
+#include "performance_counters.hpp"
 #include "stack_top_checker.hpp"
 
 #include <godot_cpp/core/error_macros.hpp>
@@ -63,8 +65,17 @@ Variant to_variant(const sol::basic_object<ref_t>& object) {
 			}
 			return object.template as<double>();
 
-		case sol::type::table:
+		case sol::type::table: {
+			// `self` tables from Lua script instances are converted back to their owner
+			lua_State *L = object.lua_state();
+			object.push(L);
+			LuaScriptInstance *script_instance = LuaScriptInstance::from_table(L, -1);
+			lua_pop(L, 1);
+			if (script_instance) {
+				return script_instance->owner;
+			}
 			return LuaObject::wrap_object<LuaTable>(object);
+		}
 
 		case sol::type::userdata:
 			if (object.template is<Variant>()) {
@@ -110,11 +121,15 @@ Variant to_variant(const sol::basic_object<ref_t>& object) {
 }
 
 Variant to_variant(const sol::object& object) {
-	return to_variant<>(object);
+	Variant variant = to_variant<>(object);
+	count_to_variant(variant.get_type());
+	return variant;
 }
 
 Variant to_variant(const sol::stack_object& object) {
-	return to_variant<>(object);
+	Variant variant = to_variant<>(object);
+	count_to_variant(variant.get_type());
+	return variant;
 }
 
 Variant to_variant(const sol::stack_proxy_base& proxy) {
@@ -162,6 +177,7 @@ Variant to_variant(lua_State *L, int index) {
 }
 
 sol::stack_object lua_push(lua_State *lua_state, const Variant& value) {
+	count_lua_push(value.get_type());
 	switch (value.get_type()) {
 		case Variant::NIL:
 			sol::stack::push(lua_state, sol::nil);
@@ -198,6 +214,11 @@ sol::stack_object lua_push(lua_State *lua_state, const Variant& value) {
 					break;
 				}
 			}
+			else if (LuaScriptInstance *script_instance = LuaScriptInstance::attached_to_object(value)) {
+				if (script_instance->push_table(lua_state)) {
+					break;
+				}
+			}
 			goto push_as_variant;
 			
 		case Variant::CALLABLE:
@@ -291,6 +312,7 @@ Variant callable_call(const Callable& callable, const VariantArguments& args) {
 }
 
 sol::object variant_static_call_string_name(sol::this_state state, Variant::Type type, const StringName& method, const VariantArguments& args) {
+	count_lua_to_godot_call();
 	VariantArguments variant_args = args;
 
 	Variant result;
@@ -303,6 +325,7 @@ sol::object variant_static_call_string_name(sol::this_state state, Variant::Type
 	return to_lua(state, result);
 }
 sol::object variant_call_string_name(sol::this_state state, Variant& variant, const StringName& method, const VariantArguments& args) {
+	count_lua_to_godot_call();
 	VariantArguments variant_args = args;
 
 	Variant result;
@@ -24,6 +24,8 @@
 #include "convert_godot_lua.hpp"
 #include "convert_godot_std.hpp"
 #include "VariantArguments.hpp"
+#include "LuaAllocationProfiler.hpp"
+#include "../script-language/LuaScriptProfiler.hpp"
 
 #include <godot_cpp/variant/packed_byte_array.hpp>
 
@@ -93,13 +95,21 @@ int sol_lua_push(lua_State* L, const luagdextension::VariantArguments &v) {
 }
 
 int resume_lua_coroutine(lua_State *L, int nargs, int *nresults) {
+	LuaAllocationProfiler::RunningThreadScope running_thread_scope(L);
+	bool is_profiling = LuaScriptProfiler::is_profiling();
+	if (is_profiling) {
+		LuaScriptProfiler::thread_resuming(L);
+	}
 #if LUA_VERSION_NUM >= 504
-	return lua_resume(L, nullptr, nargs, nresults);
+	int status = lua_resume(L, nullptr, nargs, nresults);
 #else
 	int status = lua_resume(L, nullptr, nargs);
 	if (nresults) {
 		*nresults = lua_gettop(L);
 	}
-	return status;
 #endif
+	if (is_profiling) {
+		LuaScriptProfiler::thread_suspended(L, status == LUA_YIELD);
+	}
+	return status;
 }
@@ -22,9 +22,14 @@
 #include "method_bind_impl.hpp"
 
 #include "VariantArguments.hpp"
+#include "boundary_counters.hpp"
 #include "convert_godot_lua.hpp"
+#include "performance_counters.hpp"
 #include "string_names.hpp"
+#include "../LuaCoroutine.hpp"
 #include "../LuaTable.hpp"
+#include "../script-language/LuaScript.hpp"
+#include "../script-language/LuaScriptMetadata.hpp"
 
 #include <godot_cpp/classes/class_db_singleton.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
@@ -50,6 +55,10 @@ ClassMethodBind::ClassMethodBind(const Class& cls, const StringName& method_name
 
 sol::object ClassMethodBind::call(sol::this_state state, const sol::stack_object& self, const sol::variadic_args& args) const {
 	ERR_FAIL_COND_V_MSG(!self.is<Class>() || self.as<Class&>() != cls, sol::nil, String("To call methods in Lua, use ':' instead of '.': `Class:%s(...)`") % method_name);
+	count_lua_to_godot_call();
+	if (are_boundary_counters_enabled()) {
+		record_boundary_key(BOUNDARY_CLASS_METHOD_CALL, String(cls.get_name()) + "." + String(method_name));
+	}
 	Array var_args = VariantArguments(args).get_array();
 	var_args.push_front(get_method_name());
 	var_args.push_front(cls.get_name());
@@ -64,22 +73,31 @@ void ClassMethodBind::register_usertype(sol::state_view& state) {
 // LuaScriptInstanceMethodBind
 LuaScriptInstanceMethodBind::LuaScriptInstanceMethodBind(LuaScriptInstance *instance, const StringName& method_name)
 	: BaseMethodBind(method_name)
-	, instance_owner(instance->owner)
+	, instance_owner_id(instance->owner->get_instance_id())
 {
 }
 
 Callable LuaScriptInstanceMethodBind::to_callable() const {
-	LuaScriptInstance *script_instance = LuaScriptInstance::attached_to_object(instance_owner);
+	// Owner may have been freed, so lookup by its ID before touching it
+	LuaScriptInstance *script_instance = LuaScriptInstance::attached_to_object(ObjectDB::get_instance(instance_owner_id));
 	ERR_FAIL_COND_V_MSG(script_instance == nullptr, Callable(), "Lua script instance is no longer valid");
-	return Callable(instance_owner, method_name);
+	return Callable(script_instance->owner, method_name);
 }
 
 sol::object LuaScriptInstanceMethodBind::call(sol::this_state state, const sol::stack_object& self, const sol::variadic_args& args) const {
-	LuaScriptInstance *script_instance = LuaScriptInstance::attached_to_object(instance_owner);
+	LuaScriptInstance *script_instance = LuaScriptInstance::attached_to_object(ObjectDB::get_instance(instance_owner_id));
 	ERR_FAIL_COND_V_MSG(script_instance == nullptr, sol::nil, "Lua script instance is no longer valid");
-	ERR_FAIL_COND_V_MSG(UtilityFunctions::is_same(to_variant(self), script_instance->owner), sol::nil, String("To call methods in Lua, use ':' instead of '.': `self:%s(...)`") % method_name);
-	Variant v = instance_owner;
-	return variant_call_string_name(state, v, method_name, args);
+	ERR_FAIL_COND_V_MSG(!UtilityFunctions::is_same(to_variant(self), script_instance->owner), sol::nil, String("To call methods in Lua, use ':' instead of '.': `self:%s(...)`") % method_name);
+	if (const LuaScriptMethod *method = script_instance->script->get_metadata().methods.getptr(method_name)) {
+		// Call Lua method directly instead of going through the engine
+		Array arguments = Array::make(script_instance->owner);
+		fill_array(arguments, args);
+		return to_lua(state, LuaCoroutine::invoke_lua(method->method, arguments, false));
+	}
+	else {
+		Variant v = script_instance->owner;
+		return variant_call_string_name(state, v, method_name, args);
+	}
 }
 
 void LuaScriptInstanceMethodBind::register_usertype(sol::state_view& state) {
@@ -101,6 +119,9 @@ Callable VariantMethodBind::to_callable() const {
 sol::object VariantMethodBind::call(sol::this_state state, const sol::stack_object& self, const sol::variadic_args& args) const {
 	Variant v = to_variant(self);
 	ERR_FAIL_COND_V_MSG(!UtilityFunctions::is_same(v, variant), sol::nil, String("To call methods in Lua, use ':' instead of '.': `variant:%s(...)`") % method_name);
+	if (are_boundary_counters_enabled()) {
+		record_boundary_member(BOUNDARY_VARIANT_METHOD_CALL, v, method_name);
+	}
 	return variant_call_string_name(state, v, method_name, args);
 }
 
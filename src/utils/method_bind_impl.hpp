@@ -72,7 +72,7 @@ public:
 	static void register_usertype(sol::state_view& state);
 
 protected:
-	Object *instance_owner;
+	ObjectID instance_owner_id;
 };
 
 
@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "module_resolution_cache.hpp"
+
+#include "../script-language/LuaScriptBytecodeArchive.hpp"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+
+#include <atomic>
+
+namespace luagdextension {
+
+static std::atomic<uint32_t> module_resolution_generation = 0;
+
+struct ModuleIndex {
+	HashSet<String> files;
+	bool is_valid = false;
+
+	ModuleIndex() {
+		// The index is only generated for exported projects, so never trust a stale one in the editor
+		if (OS::get_singleton()->has_feature("editor") || !FileAccess::file_exists(LUA_MODULE_INDEX_PATH)) {
+			return;
+		}
+		for (const String& file : FileAccess::get_file_as_string(LUA_MODULE_INDEX_PATH).split("\n", false)) {
+			files.insert(file);
+		}
+		is_valid = true;
+	}
+};
+
+static const ModuleIndex& get_module_index() {
+	static ModuleIndex index;
+	return index;
+}
+
+uint32_t get_module_resolution_generation() {
+	return module_resolution_generation.load(std::memory_order_relaxed);
+}
+
+void clear_module_resolution_caches() {
+	module_resolution_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool module_file_exists(const String& filename) {
+	LuaScriptBytecodeArchive *archive = LuaScriptBytecodeArchive::get_singleton();
+	if (archive && archive->has_file(filename)) {
+		return true;
+	}
+
+	const ModuleIndex& index = get_module_index();
+	if (index.is_valid && filename.begins_with("res://") && filename.ends_with(".lua")) {
+		return index.files.has(filename);
+	}
+	return FileAccess::file_exists(filename);
+}
+
+PackedByteArray build_module_index(const PackedStringArray& lua_files) {
+	return String("\n").join(lua_files).to_utf8_buffer();
+}
+
+}
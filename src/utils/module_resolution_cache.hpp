@@ -0,0 +1,47 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_MODULE_RESOLUTION_CACHE_HPP__
+#define __UTILS_MODULE_RESOLUTION_CACHE_HPP__
+
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/packed_string_array.hpp>
+#include <godot_cpp/variant/string.hpp>
+
+using namespace godot;
+
+namespace luagdextension {
+
+// Index of Lua files exported with the project, used to resolve modules without probing the filesystem
+constexpr char LUA_MODULE_INDEX_PATH[] = "res://.godot/lua_gdextension/module_index.txt";
+
+// Lua states cache the results of `package.searchpath` until this generation changes
+uint32_t get_module_resolution_generation();
+void clear_module_resolution_caches();
+
+// Returns whether `filename` exists, consulting the exported module index for `res://` Lua files if available
+bool module_file_exists(const String& filename);
+
+PackedByteArray build_module_index(const PackedStringArray& lua_files);
+
+}
+
+#endif  // __UTILS_MODULE_RESOLUTION_CACHE_HPP__
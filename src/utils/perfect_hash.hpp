@@ -0,0 +1,72 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_PERFECT_HASH_HPP__
+#define __UTILS_PERFECT_HASH_HPP__
+
+#include <cstdint>
+#include <string_view>
+
+namespace luagdextension {
+
+/**
+ * Lookup in static perfect hash tables generated by `generate_cpp_code.py`.
+ *
+ * Keys are first hashed into a bucket, whose seed is then used to hash them into
+ * a unique slot, so lookups never probe more than one entry.
+ */
+template<typename T>
+struct PerfectHashEntry {
+	const char *key;
+	T value;
+};
+
+// FNV-1a followed by MurmurHash3's finalizer. Must match `perfect_hash` in generate_cpp_code.py
+constexpr uint32_t perfect_hash(std::string_view key, uint32_t seed) {
+	uint32_t hash = 2166136261u ^ seed;
+	for (char c : key) {
+		hash ^= (uint8_t) c;
+		hash *= 16777619u;
+	}
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35u;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+template<typename T, size_t EntryCount, size_t BucketCount>
+const T *perfect_hash_find(const PerfectHashEntry<T> (&entries)[EntryCount], const uint32_t (&seeds)[BucketCount], std::string_view key) {
+	uint32_t seed = seeds[perfect_hash(key, 0) % BucketCount];
+	const PerfectHashEntry<T>& entry = entries[perfect_hash(key, seed) % EntryCount];
+	// Tables are dense, but keys that are not in the table also map to some entry
+	if (entry.key != nullptr && key == entry.key) {
+		return &entry.value;
+	}
+	else {
+		return nullptr;
+	}
+}
+
+}
+
+#endif  // __UTILS_PERFECT_HASH_HPP__
@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "performance_counters.hpp"
+
+namespace luagdextension {
+
+std::atomic<uint64_t> lua_to_godot_call_count;
+std::atomic<uint64_t> godot_to_lua_call_count;
+
+// Registry entry with the sentinel metatable, or false when uninstalled
+static const char GC_CYCLE_COUNTER_KEY[] = "_GDEXTENSION_GC_CYCLE_COUNTER";
+
+static void push_gc_sentinel(lua_State *L, uint64_t *counter) {
+	uint64_t **sentinel = (uint64_t **) lua_newuserdata(L, sizeof(uint64_t *));
+	*sentinel = counter;
+	lua_getfield(L, LUA_REGISTRYINDEX, GC_CYCLE_COUNTER_KEY);
+	lua_setmetatable(L, -2);
+}
+
+static int gc_sentinel__gc(lua_State *L) {
+	lua_getfield(L, LUA_REGISTRYINDEX, GC_CYCLE_COUNTER_KEY);
+	bool installed = lua_toboolean(L, -1);
+	lua_pop(L, 1);
+	if (installed) {
+		uint64_t *counter = *(uint64_t **) lua_touserdata(L, 1);
+		(*counter)++;
+		// New objects survive the cycle in which they are created, so the next sentinel is collected in the next cycle
+		push_gc_sentinel(L, counter);
+		lua_pop(L, 1);
+	}
+	return 0;
+}
+
+void install_gc_cycle_counter(lua_State *L, uint64_t *counter) {
+	lua_newtable(L);
+	lua_pushcfunction(L, gc_sentinel__gc);
+	lua_setfield(L, -2, "__gc");
+	lua_setfield(L, LUA_REGISTRYINDEX, GC_CYCLE_COUNTER_KEY);
+
+	push_gc_sentinel(L, counter);
+	lua_pop(L, 1);
+}
+
+void uninstall_gc_cycle_counter(lua_State *L) {
+	lua_pushboolean(L, false);
+	lua_setfield(L, LUA_REGISTRYINDEX, GC_CYCLE_COUNTER_KEY);
+}
+
+}
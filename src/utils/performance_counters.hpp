@@ -0,0 +1,51 @@
+/**
+ * Copyright (C) 2026 Gil Barbosa Reis.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the “Software”), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __UTILS_PERFORMANCE_COUNTERS_HPP__
+#define __UTILS_PERFORMANCE_COUNTERS_HPP__
+
+#include <lua.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace luagdextension {
+
+// Calls crossing the Lua <-> Godot boundary, reset every frame by LuaScriptLanguage
+extern std::atomic<uint64_t> lua_to_godot_call_count;
+extern std::atomic<uint64_t> godot_to_lua_call_count;
+
+inline void count_lua_to_godot_call() {
+	lua_to_godot_call_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void count_godot_to_lua_call() {
+	godot_to_lua_call_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Counts garbage collection cycles by keeping a finalizable sentinel that is recreated every time it's collected.
+// Uninstall it before `counter` is freed.
+void install_gc_cycle_counter(lua_State *L, uint64_t *counter);
+void uninstall_gc_cycle_counter(lua_State *L);
+
+}
+
+#endif  // __UTILS_PERFORMANCE_COUNTERS_HPP__
@@ -37,6 +37,15 @@ static void add_project_setting(ProjectSettings *project_settings, const String&
 	project_settings->set_as_internal(setting_name, is_internal);
 }
 
+static void set_project_setting_hint(ProjectSettings *project_settings, const String& setting_name, Variant::Type type, PropertyHint hint, const String& hint_string) {
+	Dictionary property_info;
+	property_info["name"] = setting_name;
+	property_info["type"] = type;
+	property_info["hint"] = hint;
+	property_info["hint_string"] = hint_string;
+	project_settings->add_property_info(property_info);
+}
+
 void register_project_settings() {
 	ProjectSettings *project_settings = ProjectSettings::get_singleton();
 #ifndef LUAJIT
@@ -48,6 +57,11 @@ void register_project_settings() {
 	add_project_setting(project_settings, LUA_CPATH_WINDOWS_SETTING, "!/?.dll;!/loadall.dll");
 	add_project_setting(project_settings, LUA_CPATH_MACOS_SETTING, "!/?.dylib;!/loadall.dylib");
 	add_project_setting(project_settings, LUA_SCRIPT_IMPORT_MAP_SETTING_EDITOR, Dictionary(), false, true);
+	add_project_setting(project_settings, LUA_SCRIPT_BYTECODE_CACHE_SETTING, true);
+	add_project_setting(project_settings, LUA_SCRIPT_GC_MODE_SETTING, 0);
+	set_project_setting_hint(project_settings, LUA_SCRIPT_GC_MODE_SETTING, Variant::INT, PROPERTY_HINT_ENUM, "Incremental,Generational");
+	add_project_setting(project_settings, LUA_SCRIPT_GC_FRAME_BUDGET_SETTING, 0);
+	set_project_setting_hint(project_settings, LUA_SCRIPT_GC_FRAME_BUDGET_SETTING, Variant::INT, PROPERTY_HINT_RANGE, "0,16000,1,or_greater,suffix:usec");
 }
 
 }
@@ -30,6 +30,9 @@ constexpr char LUA_CPATH_WINDOWS_SETTING[] = "lua_gdextension/lua_script_languag
 constexpr char LUA_CPATH_MACOS_SETTING[] = "lua_gdextension/lua_script_language/package_c_path.macos";
 constexpr char LUA_SCRIPT_IMPORT_MAP_SETTING[] = "lua_gdextension/lua_script_language/script_import_map";
 constexpr char LUA_SCRIPT_IMPORT_MAP_SETTING_EDITOR[] = "lua_gdextension/lua_script_language/script_import_map.editor";
+constexpr char LUA_SCRIPT_BYTECODE_CACHE_SETTING[] = "lua_gdextension/lua_script_language/bytecode_cache";
+constexpr char LUA_SCRIPT_GC_MODE_SETTING[] = "lua_gdextension/lua_script_language/gc/mode";
+constexpr char LUA_SCRIPT_GC_FRAME_BUDGET_SETTING[] = "lua_gdextension/lua_script_language/gc/frame_budget_usec";
 
 void register_project_settings();
 
@@ -50,6 +50,8 @@ struct string_names {
 	// LuaCoroutine / await
 	StringName completed = "completed";
 	StringName failed = "failed";
+	// LuaState
+	StringName memory_soft_limit_reached = "memory_soft_limit_reached";
 	// LuaFunction
 	StringName invoke = "invoke";
 	// Variant.__length
@@ -0,0 +1,109 @@
+extends SceneTree
+
+const BENCHMARK_DIR = "res://benchmarks"
+const DEFAULT_ITERATIONS = 10000
+const DEFAULT_THRESHOLD = 0.1
+# Allocation counts are deterministic, so small differences caused by rounding are ignored
+const ALLOCATIONS_TOLERANCE = 0.01
+
+func _process(_delta) -> bool:
+	var iterations = DEFAULT_ITERATIONS
+	var output_path = ""
+	var baseline_path = ""
+	var threshold = DEFAULT_THRESHOLD
+	var filter = ""
+	for arg in OS.get_cmdline_user_args():
+		if arg.begins_with("--iterations="):
+			iterations = arg.trim_prefix("--iterations=").to_int()
+		elif arg.begins_with("--output="):
+			output_path = arg.trim_prefix("--output=")
+		elif arg.begins_with("--baseline="):
+			baseline_path = arg.trim_prefix("--baseline=")
+		elif arg.begins_with("--threshold="):
+			threshold = arg.trim_prefix("--threshold=").to_float()
+		elif arg.begins_with("--filter="):
+			filter = arg.trim_prefix("--filter=")
+
+	print("Starting Lua GDExtension benchmarks (runtime: ", LuaState.get_lua_runtime(), ", iterations: ", iterations, ")")
+	var results = {}
+	for gdscript in DirAccess.get_files_at(BENCHMARK_DIR):
+		if not gdscript.ends_with(".gd"):
+			continue
+		print("> ", gdscript, ":")
+		var file_name = str(BENCHMARK_DIR, "/", gdscript)
+		var obj = load(file_name).new()
+		if obj is Node:
+			root.add_child(obj)
+		for method in obj.get_method_list():
+			var method_name = method.name
+			var benchmark_name = str(gdscript.get_basename(), "/", method_name)
+			if method_name.begins_with("bench") and filter in benchmark_name:
+				var result = _run_benchmark(obj, method_name, iterations)
+				results[benchmark_name] = result
+				print("  %s: %.1f ns/op, %.2f godot allocs/op, %.2f lua allocs/op" % [method_name, result.ns_per_op, result.godot_allocs_per_op, result.lua_allocs_per_op])
+		if obj is Node:
+			obj.queue_free()
+
+	if not output_path.is_empty():
+		var report = {
+			runtime = LuaState.get_lua_runtime(),
+			iterations = iterations,
+			benchmarks = results,
+		}
+		var file = FileAccess.open(output_path, FileAccess.WRITE)
+		file.store_string(JSON.stringify(report, "\t"))
+		print("Results saved to ", output_path)
+
+	var success = true
+	if not baseline_path.is_empty():
+		success = _compare_with_baseline(results, baseline_path, threshold)
+
+	quit(0 if success else 1)
+	return true
+
+
+func _run_benchmark(obj: Object, method_name: String, iterations: int) -> Dictionary:
+	LuaState.reset_allocation_counters()
+	LuaState.set_allocation_counters_enabled(true)
+	var start = Time.get_ticks_usec()
+	var operations = obj.call(method_name, iterations)
+	var elapsed_usec = Time.get_ticks_usec() - start
+	LuaState.set_allocation_counters_enabled(false)
+	var allocations = LuaState.get_allocation_counters()
+	# Expensive benchmarks may run less iterations and return how many they ran
+	if not operations is int:
+		operations = iterations
+	return {
+		ns_per_op = elapsed_usec * 1000.0 / operations,
+		godot_allocs_per_op = float(allocations.godot_allocations) / operations,
+		lua_allocs_per_op = float(allocations.lua_allocations) / operations,
+		lua_bytes_per_op = float(allocations.lua_allocated_bytes) / operations,
+	}
+
+
+func _compare_with_baseline(results: Dictionary, baseline_path: String, threshold: float) -> bool:
+	var baseline = JSON.parse_string(FileAccess.get_file_as_string(baseline_path))
+	if not baseline is Dictionary or not baseline.get("benchmarks") is Dictionary:
+		printerr("Invalid baseline file: ", baseline_path)
+		return false
+
+	print("Comparing with baseline ", baseline_path, " (threshold: ", threshold * 100, "%)")
+	var success = true
+	for benchmark_name in results:
+		var baseline_result = baseline.benchmarks.get(benchmark_name)
+		if not baseline_result is Dictionary:
+			continue
+		var result = results[benchmark_name]
+		var regressions = []
+		if result.ns_per_op > baseline_result.ns_per_op * (1.0 + threshold):
+			regressions.append("%.1f ns/op (baseline %.1f)" % [result.ns_per_op, baseline_result.ns_per_op])
+		for key in ["godot_allocs_per_op", "lua_allocs_per_op"]:
+			var limit = baseline_result.get(key, 0.0) * (1.0 + threshold) + ALLOCATIONS_TOLERANCE
+			if result[key] > limit:
+				regressions.append("%.2f %s (baseline %.2f)" % [result[key], key, baseline_result.get(key, 0.0)])
+		if not regressions.is_empty():
+			success = false
+			printerr("  ! ", benchmark_name, ": ", ", ".join(regressions))
+	if success:
+		print("  ✓ no regressions")
+	return success
@@ -0,0 +1,51 @@
+extends RefCounted
+
+var lua = LuaState.new()
+var echo: LuaFunction
+var table: LuaTable
+var object = RefCounted.new()
+var array = [1, 2, 3]
+var dictionary = { hello = "world" }
+
+
+func _init():
+	lua.open_libraries()
+	echo = lua.do_string("return function(...) return ... end")
+	table = lua.create_table()
+
+
+func bench_echo_int(iterations: int) -> void:
+	for i in iterations:
+		echo.invoke(i)
+
+
+func bench_echo_string(iterations: int) -> void:
+	for i in iterations:
+		echo.invoke("Hello world")
+
+
+func bench_echo_vector2(iterations: int) -> void:
+	var vector = Vector2(1, 2)
+	for i in iterations:
+		echo.invoke(vector)
+
+
+func bench_echo_object(iterations: int) -> void:
+	for i in iterations:
+		echo.invoke(object)
+
+
+func bench_echo_array(iterations: int) -> void:
+	for i in iterations:
+		echo.invoke(array)
+
+
+func bench_echo_dictionary(iterations: int) -> void:
+	for i in iterations:
+		echo.invoke(dictionary)
+
+
+func bench_table_set_get(iterations: int) -> void:
+	for i in iterations:
+		table.set("key", i)
+		var _value = table.get("key")
@@ -0,0 +1,29 @@
+extends RefCounted
+
+var lua = LuaState.new()
+var add_function: LuaFunction
+var yielding_function: LuaFunction
+
+
+func _init():
+	lua.open_libraries()
+	add_function = lua.do_string("return function(a, b) return a + b end")
+	yielding_function = lua.do_string("return function() coroutine.yield(1) return 2 end")
+
+
+func bench_function_invoke(iterations: int) -> void:
+	for i in iterations:
+		add_function.invoke(i, 1)
+
+
+func bench_coroutine_create_resume(iterations: int) -> void:
+	for i in iterations:
+		var coroutine = LuaCoroutine.create(add_function)
+		coroutine.resume(i, 1)
+
+
+func bench_coroutine_resume_yield(iterations: int) -> void:
+	for i in iterations:
+		var coroutine = LuaCoroutine.create(yielding_function)
+		coroutine.resume()
+		coroutine.resume()
@@ -0,0 +1,38 @@
+extends RefCounted
+
+const CHUNK_1MB_PATH = "user://benchmark_chunk_1mb.lua"
+const CHUNK_10MB_PATH = "user://benchmark_chunk_10mb.lua"
+# Loading megabytes of code is way slower than the default benchmark iterations expect
+const ITERATIONS_DIVISOR = 1000
+
+var lua = LuaState.new()
+
+
+func _init():
+	_write_chunk(CHUNK_1MB_PATH, 1024 * 1024)
+	_write_chunk(CHUNK_10MB_PATH, 10 * 1024 * 1024)
+
+
+func bench_load_file_1mb(iterations: int) -> int:
+	return _bench_load_file(CHUNK_1MB_PATH, iterations)
+
+
+func bench_load_file_10mb(iterations: int) -> int:
+	return _bench_load_file(CHUNK_10MB_PATH, iterations)
+
+
+func _bench_load_file(path: String, iterations: int) -> int:
+	var operations = maxi(iterations / ITERATIONS_DIVISOR, 1)
+	for i in operations:
+		var chunk = lua.load_file(path)
+		assert(chunk is LuaFunction)
+	return operations
+
+
+func _write_chunk(path: String, size: int) -> void:
+	var line = "t[#t + 1] = \"%s\"\n" % "x".repeat(100)
+	var file = FileAccess.open(path, FileAccess.WRITE)
+	file.store_string("local t = {}\n")
+	for i in size / line.length():
+		file.store_string(line)
+	file.store_string("return t\n")
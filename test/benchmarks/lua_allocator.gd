@@ -0,0 +1,45 @@
+extends RefCounted
+
+
+const CHURN_CODE = """
+local iterations = ...
+for i = 1, iterations do
+	local t = { i, tostring(i), { x = i } }
+	local s = t[2] .. '_' .. i
+	local f = function() return s, t end
+end
+"""
+
+var _default_lua = _create_lua(LuaState.ALLOCATOR_DEFAULT)
+var _pool_lua = _create_lua(LuaState.ALLOCATOR_POOL)
+var _default_churn: LuaFunction = _default_lua.load_string(CHURN_CODE)
+var _pool_churn: LuaFunction = _pool_lua.load_string(CHURN_CODE)
+
+
+func _init():
+	print("  pool statistics after open_libraries: %s" % _pool_lua.get_allocator_statistics())
+
+
+func bench_churn_default_allocator(iterations: int) -> void:
+	_default_churn.invoke(iterations)
+
+
+func bench_churn_pool_allocator(iterations: int) -> void:
+	_pool_churn.invoke(iterations)
+
+
+func bench_create_state_default_allocator(iterations: int) -> void:
+	for i in iterations:
+		_create_lua(LuaState.ALLOCATOR_DEFAULT)
+
+
+func bench_create_state_pool_allocator(iterations: int) -> void:
+	for i in iterations:
+		_create_lua(LuaState.ALLOCATOR_POOL)
+
+
+func _create_lua(allocator: LuaState.Allocator) -> LuaState:
+	var lua = LuaState.new()
+	lua.allocator = allocator
+	lua.open_libraries()
+	return lua
@@ -0,0 +1,10 @@
+local Processed = {}
+
+Processed.extends = Node
+Processed.elapsed = 0
+
+function Processed:_process(delta)
+	self.elapsed = self.elapsed + delta
+end
+
+return Processed
@@ -0,0 +1,8 @@
+local Spawned = {}
+
+Spawned.items = property { type = Array }
+Spawned.points = PackedVector2Array(Array { Vector2(1, 2), Vector2(3, 4) })
+Spawned.speed = 10.0
+Spawned.alive = true
+
+return Spawned
@@ -0,0 +1,32 @@
+extends RefCounted
+
+
+func _init():
+	var lua = LuaState.new()
+	lua.open_libraries()
+	print("  memory used after open_libraries: %d bytes" % lua.get_memory_used())
+
+
+func bench_create_state(iterations: int) -> void:
+	for i in iterations:
+		var _lua = LuaState.new()
+
+
+func bench_create_state_open_libraries(iterations: int) -> void:
+	for i in iterations:
+		var lua = LuaState.new()
+		lua.open_libraries()
+
+
+func bench_create_sandboxed_state(iterations: int) -> void:
+	for i in iterations:
+		var lua = LuaState.new()
+		lua.open_libraries(LuaState.LUA_BASE | LuaState.LUA_STRING | LuaState.LUA_TABLE | LuaState.LUA_MATH | LuaState.GODOT_VARIANT | LuaState.GODOT_UTILITY_FUNCTIONS | LuaState.GODOT_ENUMS)
+
+
+func bench_acquire_release_pooled_state(iterations: int) -> void:
+	var pool = LuaStatePool.new()
+	pool.prewarm(1)
+	for i in iterations:
+		var lua = pool.acquire()
+		pool.release(lua)
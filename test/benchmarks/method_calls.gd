@@ -0,0 +1,42 @@
+extends RefCounted
+
+var lua = LuaState.new()
+var vector2_method: LuaFunction
+var object_method: LuaFunction
+var static_method: LuaFunction
+var utility_function: LuaFunction
+var script_method: LuaFunction
+
+
+func _init():
+	lua.open_libraries()
+	vector2_method = _load_loop("local v = Vector2(1, 2)", "local _ = v:length()")
+	object_method = _load_loop("local obj = RefCounted:new()", "local _ = obj:get_reference_count()")
+	static_method = _load_loop("", "local _ = ClassDB:class_exists('Node')")
+	utility_function = _load_loop("", "local _ = absf(-1.5)")
+
+
+func bench_vector2_method(iterations: int) -> void:
+	vector2_method.invoke(iterations)
+
+
+func bench_object_method(iterations: int) -> void:
+	object_method.invoke(iterations)
+
+
+func bench_class_static_method(iterations: int) -> void:
+	static_method.invoke(iterations)
+
+
+func bench_utility_function(iterations: int) -> void:
+	utility_function.invoke(iterations)
+
+
+func _load_loop(setup: String, body: String) -> LuaFunction:
+	return lua.load_string("""
+		local iterations = ...
+		%s
+		for i = 1, iterations do
+			%s
+		end
+	""" % [setup, body])
@@ -0,0 +1,41 @@
+extends RefCounted
+
+var lua = LuaState.new()
+var vector2_add: LuaFunction
+var vector2_scale: LuaFunction
+var vector2_equal: LuaFunction
+var string_name_concat: LuaFunction
+
+
+func _init():
+	lua.open_libraries()
+	vector2_add = _load_loop("local v = Vector2(1, 2)", "local _ = v + v")
+	vector2_scale = _load_loop("local v = Vector2(1, 2)", "local _ = v * 2")
+	vector2_equal = _load_loop("local a, b = Vector2(1, 2), Vector2(1, 2)", "local _ = a == b")
+	string_name_concat = _load_loop("local s = StringName('name')", "local _ = s .. 'suffix'")
+
+
+func bench_vector2_add(iterations: int) -> void:
+	vector2_add.invoke(iterations)
+
+
+func bench_vector2_scale(iterations: int) -> void:
+	vector2_scale.invoke(iterations)
+
+
+func bench_vector2_equal(iterations: int) -> void:
+	vector2_equal.invoke(iterations)
+
+
+func bench_string_name_concat(iterations: int) -> void:
+	string_name_concat.invoke(iterations)
+
+
+func _load_loop(setup: String, body: String) -> LuaFunction:
+	return lua.load_string("""
+		local iterations = ...
+		%s
+		for i = 1, iterations do
+			%s
+		end
+	""" % [setup, body])
@@ -0,0 +1,41 @@
+extends RefCounted
+
+var lua = LuaState.new()
+var vector2_read: LuaFunction
+var vector2_write: LuaFunction
+var object_read: LuaFunction
+var object_write: LuaFunction
+
+
+func _init():
+	lua.open_libraries()
+	vector2_read = _load_loop("local v = Vector2(1, 2)", "local _ = v.x")
+	vector2_write = _load_loop("local v = Vector2(1, 2)", "v.x = i")
+	object_read = _load_loop("local res = Resource:new()", "local _ = res.resource_name")
+	object_write = _load_loop("local res = Resource:new()", "res.resource_name = 'name'")
+
+
+func bench_vector2_read(iterations: int) -> void:
+	vector2_read.invoke(iterations)
+
+
+func bench_vector2_write(iterations: int) -> void:
+	vector2_write.invoke(iterations)
+
+
+func bench_object_read(iterations: int) -> void:
+	object_read.invoke(iterations)
+
+
+func bench_object_write(iterations: int) -> void:
+	object_write.invoke(iterations)
+
+
+func _load_loop(setup: String, body: String) -> LuaFunction:
+	return lua.load_string("""
+		local iterations = ...
+		%s
+		for i = 1, iterations do
+			%s
+		end
+	""" % [setup, body])
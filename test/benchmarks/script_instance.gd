@@ -0,0 +1,50 @@
+extends RefCounted
+
+var spawned_script = load("res://benchmarks/lua_files/spawned.lua")
+var processed_script = load("res://benchmarks/lua_files/processed.lua")
+
+
+func bench_spawn(iterations: int) -> void:
+	var objects = []
+	objects.resize(iterations)
+	for i in iterations:
+		objects[i] = spawned_script.new()
+
+
+func bench_spawn_read_value_defaults(iterations: int) -> void:
+	var objects = []
+	objects.resize(iterations)
+	for i in iterations:
+		var obj = spawned_script.new()
+		var _speed = obj.speed
+		var _alive = obj.alive
+		var _points = obj.points
+		objects[i] = obj
+
+
+func bench_spawn_read_array_default(iterations: int) -> void:
+	var objects = []
+	objects.resize(iterations)
+	for i in iterations:
+		var obj = spawned_script.new()
+		var _items = obj.items
+		objects[i] = obj
+
+
+func bench_spawn_batch(iterations: int) -> void:
+	var _objects = spawned_script.new_batch(iterations)
+
+
+func bench_spawn_recycled(iterations: int) -> void:
+	spawned_script.instance_pool_size = 1
+	for i in iterations:
+		var obj = spawned_script.new()
+		spawned_script.recycle(obj)
+	spawned_script.instance_pool_size = 0
+
+
+func bench_process_dispatch(iterations: int) -> void:
+	var node = processed_script.new()
+	for i in iterations:
+		node._process(0.016)
+	node.free()
@@ -0,0 +1,17 @@
+extends RefCounted
+
+const SCRIPT_PATH = "res://gdscript_tests/lua_files/test_class.lua"
+const BYTECODE_CACHE_SETTING = "lua_gdextension/lua_script_language/bytecode_cache"
+
+
+func bench_load_script(iterations: int) -> void:
+	for i in iterations:
+		var _script = ResourceLoader.load(SCRIPT_PATH, "", ResourceLoader.CACHE_MODE_IGNORE)
+
+
+func bench_load_script_without_bytecode_cache(iterations: int) -> void:
+	var cache_enabled = ProjectSettings.get_setting(BYTECODE_CACHE_SETTING)
+	ProjectSettings.set_setting(BYTECODE_CACHE_SETTING, false)
+	for i in iterations:
+		var _script = ResourceLoader.load(SCRIPT_PATH, "", ResourceLoader.CACHE_MODE_IGNORE)
+	ProjectSettings.set_setting(BYTECODE_CACHE_SETTING, cache_enabled)
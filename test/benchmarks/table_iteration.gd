@@ -0,0 +1,52 @@
+extends RefCounted
+
+const ITEMS = 100
+
+var lua = LuaState.new()
+var table: LuaTable
+var array_pairs: LuaFunction
+var dictionary_pairs: LuaFunction
+
+
+func _init():
+	lua.open_libraries()
+	table = lua.create_table()
+	for i in ITEMS:
+		table.set(i + 1, i)
+	array_pairs = lua.load_string("""
+		local iterations, items = ...
+		local array = Array()
+		array:resize(items)
+		for i = 1, iterations / items do
+			for _, _ in pairs(array) do end
+		end
+	""")
+	dictionary_pairs = lua.load_string("""
+		local iterations, items = ...
+		local dictionary = Dictionary()
+		for i = 1, items do
+			dictionary[i] = i
+		end
+		for i = 1, iterations / items do
+			for _, _ in pairs(dictionary) do end
+		end
+	""")
+
+
+# Each operation is a single element iterated
+func bench_lua_table_from_gdscript(iterations: int) -> int:
+	var operations = maxi(iterations / ITEMS, 1)
+	for i in operations:
+		for _key in table:
+			pass
+	return operations * ITEMS
+
+
+func bench_array_pairs_from_lua(iterations: int) -> int:
+	array_pairs.invoke(iterations, ITEMS)
+	return maxi(iterations / ITEMS, 1) * ITEMS
+
+
+func bench_dictionary_pairs_from_lua(iterations: int) -> int:
+	dictionary_pairs.invoke(iterations, ITEMS)
+	return maxi(iterations / ITEMS, 1) * ITEMS
@@ -66,6 +66,15 @@ func test_get_debug_info() -> bool:
 	return true
 
 
+func test_dump() -> bool:
+	var bytecode = lua_state.load_string("return ...").dump()
+	assert(not bytecode.is_empty())
+	var loaded_function = lua_state.load_buffer(bytecode, "", LuaState.LOAD_MODE_BINARY)
+	assert(loaded_function is LuaFunction, "Dumped bytecode should be loadable in binary mode")
+	assert(_test_call(loaded_function, [5]) == 5)
+	return true
+
+
 func _test_call(f: LuaFunction, args: Array = []):
 	var result = f.invokev(args)
 	if result is LuaError:
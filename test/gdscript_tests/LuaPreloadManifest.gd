@@ -0,0 +1,60 @@
+extends RefCounted
+
+const MODULE_A = "res://gdscript_tests/lua_files/preload_module_a.lua"
+const MODULE_B = "res://gdscript_tests/lua_files/preload_module_b.lua"
+
+
+func test_require_graph() -> bool:
+	var graph = LuaPreloadManifest.get_require_graph([MODULE_A])
+	assert(graph.size() == 2)
+	assert(graph[MODULE_A] == PackedStringArray([MODULE_B]))
+	assert(graph[MODULE_B].is_empty())
+	return true
+
+
+func test_preload() -> bool:
+	var manifest = LuaPreloadManifest.new()
+	manifest.modules = [MODULE_B, MODULE_A]
+	manifest.start_preload()
+	manifest.wait_preload()
+	assert(manifest.is_preload_done())
+
+	var lua = LuaState.new()
+	lua.open_libraries()
+	assert(lua.do_string('return require("gdscript_tests.lua_files.preload_module_a")') == 42)
+
+	manifest.clear_preloaded()
+	assert(not manifest.is_preload_done())
+	return true
+
+
+func test_preload_uses_preloaded_bytecode() -> bool:
+	var path = "user://preload_manifest_test_module.lua"
+	var file = FileAccess.open(path, FileAccess.WRITE)
+	file.store_string("return 'preloaded'")
+	file.close()
+
+	var manifest = LuaPreloadManifest.new()
+	manifest.modules = [path]
+	manifest.start_preload()
+	manifest.wait_preload()
+
+	# Changing the source after preloading must not affect what `require` loads
+	file = FileAccess.open(path, FileAccess.WRITE)
+	file.store_string("return 'source'")
+	file.close()
+
+	var lua = LuaState.new()
+	lua.open_libraries()
+	lua.package_path = "user://?.lua"
+	assert(lua.do_string('return require("preload_manifest_test_module")') == "preloaded")
+	assert(lua.do_string('return loadfile("user://preload_manifest_test_module.lua", "t")()') == "source", "Loading text only should not use preloaded bytecode")
+
+	manifest.clear_preloaded()
+	lua = LuaState.new()
+	lua.open_libraries()
+	lua.package_path = "user://?.lua"
+	assert(lua.do_string('return require("preload_manifest_test_module")') == "source")
+
+	DirAccess.remove_absolute(path)
+	return true
@@ -0,0 +1,66 @@
+extends RefCounted
+
+var profiled_class = load("res://gdscript_tests/lua_files/profiled_class.lua")
+
+
+func _get_lua_script_language() -> LuaScriptLanguage:
+	for i in Engine.get_script_language_count():
+		var language = Engine.get_script_language(i)
+		if language is LuaScriptLanguage:
+			return language
+	return null
+
+
+func test_profiler_after_error() -> bool:
+	var language = _get_lua_script_language()
+	var obj = profiled_class.new()
+	language.profiling_start()
+	obj.call_catches_error()
+	obj.call_catches_error()
+	language.profiling_stop()
+
+	var catches_error_profile = null
+	for profile in language.get_profiling_data():
+		if profile.signature.ends_with("::catches_error"):
+			catches_error_profile = profile
+	assert(catches_error_profile != null, "Functions that caught errors should be profiled")
+	assert(catches_error_profile.call_count == 2, "Frames unwound by errors should not be mistaken for their callers")
+	return true
+
+
+func test_static_global_class_table_constructor() -> bool:
+	var info = _get_lua_script_language().get_static_global_class_info("res://gdscript_tests/lua_files/static_table_constructor.lua")
+	assert(info is Dictionary, "Table constructors with literal values should be analyzed statically")
+	assert(info.name == "StaticTableConstructor")
+	assert(info.base_type == "Node")
+	assert(info.icon_path == "res://icon.svg")
+	assert(info.is_tool)
+	return true
+
+
+func test_static_global_class_gdclass_fields() -> bool:
+	var info = _get_lua_script_language().get_static_global_class_info("res://gdscript_tests/lua_files/static_gdclass.lua")
+	assert(info is Dictionary, "GDCLASS tables with metadata assigned to fields should be analyzed statically")
+	assert(info.name == "StaticGDClass")
+	assert(info.base_type == "Node2D")
+	assert(not info.is_tool)
+	return true
+
+
+func test_static_global_class_lua_base_script() -> bool:
+	var info = _get_lua_script_language().get_static_global_class_info("res://gdscript_tests/lua_files/static_lua_base.lua")
+	assert(info is Dictionary, "Lua base scripts should be followed statically")
+	assert(info.name == "StaticLuaBase")
+	assert(info.base_type == "Node2D", "Base type should come from the base script")
+	assert(info.icon_path == "res://icon.svg", "Icon should be inherited from the base script")
+	return true
+
+
+func test_static_global_class_fallback() -> bool:
+	var language = _get_lua_script_language()
+	var path = "res://gdscript_tests/lua_files/static_runtime_class_name.lua"
+	assert(language.get_static_global_class_info(path) == null, "Values computed at runtime cannot be analyzed statically")
+	var info = language.get_global_class_info(path)
+	assert(info.name == "RuntimeClassName", "Scripts that cannot be analyzed statically should be loaded")
+	assert(info.base_type == "RefCounted")
+	return true
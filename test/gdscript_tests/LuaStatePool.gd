@@ -0,0 +1,93 @@
+extends RefCounted
+
+
+func test_acquire_release() -> bool:
+	var pool = LuaStatePool.new()
+	pool.prewarm(1)
+	assert(pool.get_available_count() == 1)
+
+	var lua = pool.acquire()
+	assert(lua is LuaState)
+	assert(pool.get_available_count() == 0)
+	assert(pool.release(lua))
+	assert(pool.get_available_count() == 1)
+	assert(is_same(pool.acquire(), lua))
+
+	var statistics = pool.get_statistics()
+	assert(statistics.hits == 1)
+	assert(statistics.misses == 0)
+	assert(statistics.resets == 1)
+	return true
+
+
+func test_reset() -> bool:
+	var pool = LuaStatePool.new()
+	var lua = pool.acquire()
+	lua.do_string("""
+		some_global = 42
+		print = nil
+		package.loaded.some_module = {}
+		setmetatable(_G, nil)
+	""")
+	pool.release(lua)
+	lua = pool.acquire()
+	assert(lua.globals.rawget("some_global") == null, "User globals should be cleared")
+	assert(lua.do_string("return print ~= nil"), "Baseline globals should be restored")
+	assert(lua.do_string("return package.loaded.some_module == nil"), "User modules should be unloaded")
+	assert(lua.do_string("return Vector2(1, 2)") == Vector2(1, 2), "Lazy globals should work after reset")
+	return true
+
+
+func test_reset_library_tables() -> bool:
+	var pool = LuaStatePool.new()
+	var lua = pool.acquire()
+	var original_path = lua.do_string("return package.path")
+	lua.do_string("""
+		string.format = nil
+		string.custom = function() end
+		table.insert(package.searchers, function() end)
+		package.path = "res://custom/?.lua"
+	""")
+	pool.release(lua)
+	lua = pool.acquire()
+	assert(lua.do_string("return string.format('%d', 1)") == "1", "Replaced library functions should be restored")
+	assert(lua.do_string("return string.custom == nil"), "Functions added to library tables should be removed")
+	assert(lua.do_string("return ('%d'):format(2)") == "2", "String methods should be restored")
+	assert(lua.do_string("return package.path") == original_path, "Package fields should be restored")
+	assert(lua.do_string("return #package.searchers") == pool.acquire().do_string("return #package.searchers"), "Package searchers should be restored")
+	return true
+
+
+func test_reset_metatables_hooks_and_limits() -> bool:
+	var pool = LuaStatePool.new()
+	var lua = pool.acquire()
+	lua.do_string("""
+		setmetatable(string, { __index = function() return "leaked" end })
+		getmetatable("").__index = { len = function() return -1 end }
+		debug.sethook(function() end, "l")
+	""")
+	lua.memory_limit = 1024 * 1024 * 1024
+	lua.memory_soft_limit = 1024 * 1024 * 1024
+	assert(pool.release(lua))
+	lua = pool.acquire()
+	assert(lua.do_string("return getmetatable(string) == nil"), "Library table metatables should be restored")
+	assert(lua.do_string("return ('abc'):len()") == 3, "The string metatable should be restored")
+	assert(lua.do_string("return debug.gethook() == nil"), "Hooks should be removed")
+	assert(lua.memory_limit == 0)
+	assert(lua.memory_soft_limit == 0)
+	return true
+
+
+func test_release_after_libraries_change() -> bool:
+	var pool = LuaStatePool.new()
+	var lua = pool.acquire()
+	pool.libraries = LuaState.LUA_BASE
+	assert(not pool.release(lua), "States with outdated libraries should not be pooled")
+	assert(pool.get_available_count() == 0)
+	return true
+
+
+func test_release_foreign_state() -> bool:
+	var pool = LuaStatePool.new()
+	assert(not pool.release(LuaState.new()))
+	return true
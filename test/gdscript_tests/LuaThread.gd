@@ -53,5 +53,56 @@ func test_get_hook() -> bool:
 	return true
 
 
+func test_sampling_profiler() -> bool:
+	var main_thread = lua_state.main_thread
+	main_thread.start_sampling_profiler(100)
+	assert(main_thread.is_sampling_profiler_running())
+	lua_state.do_string("""
+		local function busy_loop()
+			local sum = 0
+			for i = 1, 100000 do
+				sum = sum + i
+			end
+			return sum
+		end
+		busy_loop()
+	""", "sampling_profiler_test")
+	main_thread.stop_sampling_profiler()
+	assert(not main_thread.is_sampling_profiler_running())
+
+	var profile = lua_state.get_sampling_profile()
+	assert(profile.keys().any(func(stack): return "busy_loop" in stack), "Samples should be attributed to the running function")
+	var path = "user://sampling_profile_test.json"
+	assert(lua_state.save_sampling_profile(path, LuaState.PROFILE_FORMAT_SPEEDSCOPE) == OK)
+	var speedscope = JSON.parse_string(FileAccess.get_file_as_string(path))
+	assert(speedscope["profiles"][0]["type"] == "sampled")
+	DirAccess.remove_absolute(path)
+
+	lua_state.clear_sampling_profile()
+	assert(lua_state.get_sampling_profile().is_empty())
+	return true
+
+
+func test_sampling_profiler_stops_in_coroutines() -> bool:
+	var main_thread = lua_state.main_thread
+	main_thread.start_sampling_profiler(100)
+	var coroutine = lua_state.do_string("""
+		return coroutine.create(function()
+			local sum = 0
+			for i = 1, 100000 do
+				sum = sum + i
+			end
+			return sum
+		end)
+	""")
+	main_thread.stop_sampling_profiler()
+	lua_state.clear_sampling_profile()
+
+	coroutine.resume()
+	assert(not coroutine.is_sampling_profiler_running())
+	assert(lua_state.get_sampling_profile().is_empty(), "Coroutines should stop sampling together with the thread they inherited the profiler from")
+	return true
+
+
 func _func_call_hook(debug):
 	_hook_call_count += 1
@@ -0,0 +1,79 @@
+extends RefCounted
+
+# Allocations are measured per iteration of a Lua loop, discounting the loop itself and its setup
+const ITERATIONS = 1000
+# Allowed average allocations per iteration above the budget, for sporadic allocations like table resizes
+const TOLERANCE = 0.01
+
+var lua = LuaState.new()
+
+
+func _init():
+	lua.open_libraries()
+
+
+func test_vector2_field_read() -> bool:
+	var allocations = _allocations_per_iteration("local v = Vector2(1, 2)", "local _ = v.x")
+	assert(allocations.godot_allocations <= TOLERANCE, "Vector2 field read should not allocate Godot memory, got %s" % allocations)
+	assert(allocations.lua_allocations <= TOLERANCE, "Vector2 field read should not allocate Lua memory, got %s" % allocations)
+	return true
+
+
+func test_vector2_field_write() -> bool:
+	var allocations = _allocations_per_iteration("local v = Vector2(1, 2)", "v.x = i")
+	assert(allocations.godot_allocations <= TOLERANCE, "Vector2 field write should not allocate Godot memory, got %s" % allocations)
+	assert(allocations.lua_allocations <= TOLERANCE, "Vector2 field write should not allocate Lua memory, got %s" % allocations)
+	return true
+
+
+func test_array_index_read() -> bool:
+	var allocations = _allocations_per_iteration("local array = Array { 1, 2, 3 }", "local _ = array[0]")
+	assert(allocations.godot_allocations <= TOLERANCE, "Array index read should not allocate Godot memory, got %s" % allocations)
+	assert(allocations.lua_allocations <= TOLERANCE, "Array index read should not allocate Lua memory, got %s" % allocations)
+	return true
+
+
+func test_vector2_operator() -> bool:
+	var allocations = _allocations_per_iteration("local v = Vector2(1, 2)", "local _ = v + v")
+	assert(allocations.godot_allocations <= TOLERANCE, "Vector2 addition should not allocate Godot memory, got %s" % allocations)
+	assert(allocations.lua_allocations <= 1 + TOLERANCE, "Vector2 addition should only allocate its result, got %s" % allocations)
+	return true
+
+
+func test_vector2_method_without_arguments() -> bool:
+	var allocations = _allocations_per_iteration("local v = Vector2(1, 2)", "local _ = v:length()")
+	assert(allocations.godot_allocations <= TOLERANCE, "Method calls without arguments should not allocate Godot memory, got %s" % allocations)
+	assert(allocations.lua_allocations <= 1 + TOLERANCE, "Method calls should only allocate the method bind, got %s" % allocations)
+	return true
+
+
+func test_vector2_method_with_argument() -> bool:
+	var allocations = _allocations_per_iteration("local v = Vector2(1, 2)", "local _ = v:distance_to(v)")
+	assert(allocations.godot_allocations <= 1 + TOLERANCE, "Method calls should allocate at most the argument pointers, got %s" % allocations)
+	assert(allocations.lua_allocations <= 1 + TOLERANCE, "Method calls should only allocate the method bind, got %s" % allocations)
+	return true
+
+
+func _allocations_per_iteration(setup: String, body: String) -> Dictionary:
+	var loop = _load_loop(setup, body)
+	var empty_loop = _load_loop(setup, "")
+	# Warm up lazily created globals and caches
+	loop.invoke(ITERATIONS)
+	empty_loop.invoke(ITERATIONS)
+
+	var counts = LuaState.count_allocations(func(): loop.invoke(ITERATIONS))
+	var empty_counts = LuaState.count_allocations(func(): empty_loop.invoke(ITERATIONS))
+	var result = {}
+	for key in counts:
+		result[key] = float(counts[key] - empty_counts[key]) / ITERATIONS
+	return result
+
+
+func _load_loop(setup: String, body: String) -> LuaFunction:
+	return lua.load_string("""
+		local iterations = ...
+		%s
+		for i = 1, iterations do
+			%s
+		end
+	""" % [setup, body])
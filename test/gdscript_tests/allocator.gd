@@ -0,0 +1,166 @@
+extends RefCounted
+
+
+func test_pool_allocator() -> bool:
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+	var lua = LuaState.new()
+	lua.allocator = LuaState.ALLOCATOR_POOL
+	assert(lua.allocator == LuaState.ALLOCATOR_POOL)
+	lua.open_libraries()
+	var result = lua.do_string("""
+		local t = {}
+		for i = 1, 1000 do
+			t[i] = { tostring(i) }
+		end
+		t = nil
+		collectgarbage()
+		return string.rep('x', 1000)
+	""")
+	assert(result == "x".repeat(1000))
+	var statistics = lua.get_allocator_statistics()
+	assert(statistics.small_allocations > 0)
+	assert(statistics.slab_count > 0)
+	assert(statistics.bytes_in_use == lua.get_memory_used())
+	return true
+
+
+func test_default_allocator_statistics() -> bool:
+	var lua = LuaState.new()
+	assert(lua.allocator == LuaState.ALLOCATOR_DEFAULT)
+	lua.open_libraries()
+	var statistics = lua.get_allocator_statistics()
+	assert(statistics.small_allocations == 0)
+	assert(statistics.bytes_in_use > 0)
+	return true
+
+
+func test_memory_limit() -> bool:
+	var lua = LuaState.new()
+	lua.open_libraries()
+	lua.memory_limit = lua.get_memory_used() + 1024 * 1024
+	var result = lua.do_string("""
+		local t = {}
+		for i = 1, 10000000 do
+			t[i] = tostring(i)
+		end
+	""")
+	assert(result is LuaError)
+	assert(result.status == LuaError.MEMORY)
+	assert(lua.get_memory_used() <= lua.memory_limit)
+	assert(lua.get_allocator_statistics().failed_allocations > 0)
+	lua.memory_limit = 0
+	lua.collect_garbage()
+	assert(lua.do_string("return 'still usable'") == "still usable")
+	return true
+
+
+func test_table_set_under_memory_limit() -> bool:
+	var lua = LuaState.new()
+	lua.open_libraries()
+	lua.memory_limit = lua.get_memory_used() + 1024
+	var big_string = "x".repeat(64 * 1024)
+	lua.globals.big_string = big_string
+	assert(lua.globals.big_string == null, "Setting a field past the memory limit should fail without panicking")
+	lua.memory_limit = 0
+	lua.globals.big_string = big_string
+	assert(lua.globals.big_string == big_string)
+	return true
+
+
+func test_shrink_under_memory_limit() -> bool:
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+	var lua = LuaState.new()
+	lua.allocator = LuaState.ALLOCATOR_POOL
+	lua.open_libraries()
+	lua.do_string("""
+		strings = {}
+		for i = 1, 10000 do
+			strings[i] = "string " .. i
+		end
+		local function recurse(n)
+			if n > 0 then
+				return recurse(n - 1) + 1
+			end
+			return 0
+		end
+		recurse(1000)
+	""")
+	# Only leave room for compiling the chunk below: the string table and stack shrink when collecting
+	lua.memory_limit = lua.get_memory_used() + 16 * 1024
+	var result = lua.do_string("""
+		strings = nil
+		collectgarbage()
+		collectgarbage()
+		return 'shrunk'
+	""")
+	assert(result == "shrunk", "Shrinking blocks should never fail, got %s" % result)
+	assert(lua.get_allocator_statistics().bytes_in_use == lua.get_memory_used())
+	lua.memory_limit = 0
+	assert(lua.do_string("return 'still usable'") == "still usable")
+	return true
+
+
+func test_memory_peak() -> bool:
+	var lua = LuaState.new()
+	lua.open_libraries()
+	lua.reset_memory_peak()
+	var peak = lua.get_memory_peak()
+	lua.do_string("local s = string.rep('x', 100000)")
+	lua.collect_garbage()
+	assert(lua.get_memory_peak() >= peak + 100000)
+	assert(lua.get_memory_used() < lua.get_memory_peak())
+	lua.reset_memory_peak()
+	assert(lua.get_memory_peak() == lua.get_memory_used())
+	return true
+
+
+func test_allocation_profiler() -> bool:
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+	var lua = LuaState.new()
+	lua.open_libraries()
+	lua.start_allocation_profiler(1024)
+	assert(lua.is_allocation_profiler_running())
+	lua.do_string("""
+		kept = {}
+		for i = 1, 1000 do
+			kept[i] = string.rep('x', 100) .. i
+		end
+	""", "allocating_chunk")
+	lua.stop_allocation_profiler()
+	assert(not lua.is_allocation_profiler_running())
+	var profile = lua.get_allocation_profile()
+	var location = profile.keys().filter(func(key): return key.begins_with("[string \"allocating_chunk\"]"))
+	assert(not location.is_empty(), "Allocations should be attributed to the chunk that made them")
+	assert(profile[location[0]].total_bytes > 0)
+	assert(profile[location[0]].live_bytes > 0)
+
+	var path = "user://allocation_profile.folded"
+	assert(lua.save_allocation_profile(path) == OK)
+	assert(FileAccess.get_file_as_string(path).contains("allocating_chunk"))
+	DirAccess.remove_absolute(path)
+	return true
+
+
+func test_allocation_profiler_while_growing_stack() -> bool:
+	if LuaState.get_lua_runtime() == "luajit":
+		return true
+	var lua = LuaState.new()
+	lua.open_libraries()
+	# Sample every allocation, including the ones that reallocate the Lua stack
+	lua.start_allocation_profiler(1)
+	var result = lua.do_string("""
+		local function recurse(n)
+			if n > 0 then
+				return recurse(n - 1) + 1
+			end
+			return 0
+		end
+		return recurse(10000)
+	""", "recursive_chunk")
+	lua.stop_allocation_profiler()
+	assert(result == 10000, "Profiling allocations should not disturb a growing stack, got %s" % result)
+	assert(lua.get_allocation_profile().keys().any(func(key): return key.begins_with("[string \"recursive_chunk\"]")))
+	return true
@@ -10,3 +10,17 @@ func test_libraries_opened() -> bool:
 	assert(lua_state.are_libraries_opened(LuaState.LUA_BASE | LuaState.LUA_PACKAGE))
 	assert(not lua_state.are_libraries_opened(LuaState.LUA_ALL_LIBS))
 	return true
+
+
+func test_lazy_globals() -> bool:
+	var lua_state = LuaState.new()
+	lua_state.open_libraries(LuaState.LUA_BASE | LuaState.GODOT_ENUMS)
+	assert(lua_state.globals.rawget("SIDE_LEFT") == null, "Enums should be defined on demand")
+	assert(lua_state.do_string("return SIDE_LEFT") == SIDE_LEFT)
+	assert(lua_state.globals.rawget("SIDE_LEFT") == SIDE_LEFT, "Enums should be cached after first access")
+	assert(lua_state.do_string("return Vector2") == null, "Globals from libraries that were not opened should not be defined")
+
+	lua_state.open_libraries(LuaState.GODOT_VARIANT | LuaState.GODOT_UTILITY_FUNCTIONS)
+	assert(lua_state.do_string("return Vector2(1, 2)") == Vector2(1, 2))
+	assert(lua_state.do_string("return absi(-1)") == 1)
+	return true
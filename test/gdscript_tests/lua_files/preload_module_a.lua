@@ -0,0 +1,2 @@
+local b = require("gdscript_tests.lua_files.preload_module_b")
+return b + 1
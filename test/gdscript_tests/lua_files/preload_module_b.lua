@@ -0,0 +1 @@
+return 41
@@ -0,0 +1,14 @@
+local ProfiledClass = {}
+
+local function catches_error()
+	-- The anonymous function is unwound by the error, so its return hook is never called
+	pcall(function()
+		error("expected error")
+	end)
+end
+
+function ProfiledClass:call_catches_error()
+	catches_error()
+end
+
+return ProfiledClass
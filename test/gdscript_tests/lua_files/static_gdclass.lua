@@ -0,0 +1,12 @@
+local StaticGDClass = GDCLASS()
+StaticGDClass.class_name = "StaticGDClass"
+StaticGDClass.extends = Node2D
+StaticGDClass.icon = "res://icon.svg"
+
+StaticGDClass.health = 10
+
+function StaticGDClass:_ready()
+	self.health = 20
+end
+
+return StaticGDClass
@@ -0,0 +1,6 @@
+local StaticLuaBase = {
+	class_name = "StaticLuaBase",
+	extends = "static_gdclass.lua",
+}
+
+return StaticLuaBase
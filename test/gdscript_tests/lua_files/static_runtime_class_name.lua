@@ -0,0 +1,4 @@
+local RuntimeClassName = {}
+RuntimeClassName.class_name = "Runtime" .. "ClassName"
+
+return RuntimeClassName
@@ -0,0 +1,6 @@
+return {
+	class_name = "StaticTableConstructor",
+	extends = Node,
+	icon = "res://icon.svg",
+	tool = true,
+}
@@ -0,0 +1,12 @@
+local TestClassAwaitInit = {}
+
+TestClassAwaitInit.initialized = false
+
+function TestClassAwaitInit:_init(sig)
+	if sig then
+		await(sig)
+	end
+	self.initialized = true
+end
+
+return TestClassAwaitInit
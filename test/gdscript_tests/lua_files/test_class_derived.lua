@@ -0,0 +1,15 @@
+local TestClassDerived = {
+	extends = "test_class.lua",
+}
+
+TestClassDerived.derived_property = 42
+
+function TestClassDerived:echo(value)
+	return value * 2
+end
+
+function TestClassDerived:derived_method()
+	return "derived"
+end
+
+return TestClassDerived
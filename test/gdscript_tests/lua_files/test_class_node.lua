@@ -2,10 +2,38 @@ local TestClassNode = {
 	extends = Node,
 }
 
+TestClassNode.health = 10
+TestClassNode.clamped = property {
+	set = function(self, value)
+		self:rawset("clamped", math.min(value, 3))
+	end,
+}
+
 function TestClassNode:_init()
 	self._init_called = true
 end
 
+-- `self` table
+function TestClassNode:self_is_table()
+	return type(self) == "table"
+end
+
+function TestClassNode:damage(amount)
+	self.health = self.health - amount
+end
+
+function TestClassNode:get_health_from_lua()
+	return self.health
+end
+
+function TestClassNode:get_name_from_lua()
+	return self.name
+end
+
+function TestClassNode:set_clamped_from_lua(value)
+	self.clamped = value
+end
+
 -- RPC config
 function TestClassNode:rpc_method()
 	self.rpc_called = true
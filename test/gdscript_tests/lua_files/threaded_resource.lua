@@ -0,0 +1,11 @@
+local ThreadedResource = {
+	extends = Resource,
+}
+
+ThreadedResource.value = export(1)
+
+function ThreadedResource:_init()
+	self.init_called = true
+end
+
+return ThreadedResource
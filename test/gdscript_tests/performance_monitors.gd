@@ -0,0 +1,55 @@
+extends RefCounted
+
+
+func test_gc_cycle_count() -> bool:
+	var lua = LuaState.new()
+	var cycles = lua.get_gc_cycle_count()
+	lua.collect_garbage()
+	assert(lua.get_gc_cycle_count() > cycles)
+	return true
+
+
+func test_add_performance_monitors() -> bool:
+	var lua = LuaState.new()
+	lua.add_performance_monitors("LuaTest")
+	assert(Performance.has_custom_monitor("LuaTest/Memory used (bytes)"))
+	assert(Performance.get_custom_monitor("LuaTest/Memory used (bytes)") == lua.get_memory_used())
+	lua.remove_performance_monitors()
+	assert(not Performance.has_custom_monitor("LuaTest/Memory used (bytes)"))
+	return true
+
+
+func test_script_language_monitors() -> bool:
+	assert(Performance.has_custom_monitor("Lua/Memory used (bytes)"))
+	assert(Performance.has_custom_monitor("Lua/Script instances"))
+	return true
+
+
+func test_boundary_counters() -> bool:
+	var lua = LuaState.new()
+	lua.open_libraries()
+	LuaState.reset_boundary_counters()
+	LuaState.set_boundary_counters_enabled(true)
+	lua.do_string("""
+		local v = Vector2(1, 2)
+		for i = 1, 10 do
+			local x = v.x
+			v = v + v
+		end
+	""")
+	LuaState.set_boundary_counters_enabled(false)
+
+	var report = LuaState.get_boundary_counter_report()
+	var counts = {}
+	for entry in report:
+		counts[entry.category + "/" + entry.key] = entry.count
+	assert(counts.get("variant__index/Vector2.x") == 10)
+	assert(counts.get("binary_operator/+") == 10)
+	for i in range(1, report.size()):
+		assert(report[i - 1].count >= report[i].count, "Report should be sorted by count")
+
+	lua.do_string("local x = Vector2(1, 2).x")
+	assert(LuaState.get_boundary_counter_report() == report, "Disabled counters should not change")
+	LuaState.reset_boundary_counters()
+	assert(LuaState.get_boundary_counter_report().is_empty())
+	return true
@@ -3,6 +3,8 @@ extends RefCounted
 signal some_signal()
 
 var test_class = load("res://gdscript_tests/lua_files/test_class.lua")
+var test_class_derived = load("res://gdscript_tests/lua_files/test_class_derived.lua")
+var test_class_await_init = load("res://gdscript_tests/lua_files/test_class_await_init.lua")
 var test_class_scene: PackedScene = load("res://gdscript_tests/scene_files/test_class.tscn")
 var _signal_handled = false
 
@@ -23,6 +25,53 @@ func test_init() -> bool:
 	return true
 
 
+func test_new_batch() -> bool:
+	var objects = test_class.new_batch(3, [1, 2])
+	assert(objects.size() == 3)
+	for obj in objects:
+		assert(obj.get_script() == test_class)
+		assert(obj.init_values == [1, 2])
+	assert(!is_same(objects[0].empty_array, objects[1].empty_array))
+	return true
+
+
+func test_new_batch_await_init() -> bool:
+	var objects = test_class_await_init.new_batch(2)
+	assert(objects.all(func(obj): return obj.initialized), "Non-awaiting _init should finish before new_batch returns")
+	objects = test_class_await_init.new_batch(2, [some_signal])
+	assert(not objects.any(func(obj): return obj.initialized), "Awaiting _init should be suspended")
+	some_signal.emit()
+	assert(objects.all(func(obj): return obj.initialized), "Awaiting _init should resume like in new")
+	return true
+
+
+func test_recycle() -> bool:
+	test_class.instance_pool_size = 1
+	var obj = test_class.new(1)
+	obj.some_variable = "value"
+	assert(test_class.recycle(obj))
+	assert(!test_class.recycle(test_class.new()), "Pool should be full")
+	var recycled = test_class.new(2)
+	assert(is_same(recycled, obj))
+	assert(recycled.init_values == [2])
+	assert(recycled.rawget("some_variable") == null, "Recycled instances should have their variables reset")
+	test_class.instance_pool_size = 0
+	return true
+
+
+func test_recycle_twice() -> bool:
+	test_class.instance_pool_size = 2
+	var obj = test_class.new()
+	assert(test_class.recycle(obj))
+	assert(!test_class.recycle(obj), "Objects already in the pool should not be recycled again")
+	var recycled = test_class.new()
+	var other = test_class.new()
+	assert(is_same(recycled, obj))
+	assert(!is_same(other, obj), "The same object should not be handed out twice")
+	test_class.instance_pool_size = 0
+	return true
+
+
 func test_init_scene() -> bool:
 	var obj = test_class_scene.instantiate()
 	assert(obj._init_called == true)
@@ -51,6 +100,15 @@ func test_array_properties() -> bool:
 	return true
 
 
+func test_shared_property_defaults() -> bool:
+	var obj = test_class.new()
+	assert(obj.signal_awaited == false)
+	assert(obj.rawget("signal_awaited") == null, "Defaults passed by value should not be stored per instance")
+	assert(obj.empty_array == [])
+	assert(obj.rawget("empty_array") == [], "Array defaults should be stored per instance")
+	return true
+
+
 func test_non_existent_property() -> bool:
 	var obj = test_class.new()
 	assert(obj.get("some crazy non-existent property name") == null)
@@ -146,3 +204,64 @@ func test_get_method_list() -> bool:
 	assert(methods.any(func(mi): return mi.name == "get_a"))
 	assert(methods.any(func(mi): return mi.name == "await_signal"))
 	return true
+
+
+func test_inheritance() -> bool:
+	assert(test_class_derived.get_base_script() == test_class)
+	assert(test_class_derived.get_instance_base_type() == test_class.get_instance_base_type())
+	var obj = test_class_derived.new(1)
+	assert(obj.init_values == [1], "Base script methods should be inherited")
+	assert(obj.echo(2) == 4, "Derived script methods should override base ones")
+	assert(obj.derived_method() == "derived")
+	assert(obj.derived_property == 42)
+	assert(obj.getter_name == "a", "Base script properties should be inherited")
+	assert(obj.some_signal is Signal, "Base script signals should be inherited")
+	return true
+
+
+func test_looks_like_godot_script() -> bool:
+	assert(test_class.get_looks_like_godot_script())
+	assert(test_class.get_looks_like_godot_script(), "Cached analysis should return the same result")
+	if OS.has_feature("editor"):
+		_get_lua_script_language().save_script_analysis_cache()
+		var cache_file = FileAccess.open("res://.godot/lua_gdextension/script_analysis.cache", FileAccess.READ)
+		assert(cache_file != null, "Analysis cache should be saved in the editor")
+		var cache = cache_file.get_var()
+		assert(cache.get(test_class.resource_path) == [test_class.source_code.md5_text(), true], "Analysis cache should persist the script's result")
+	return true
+
+
+func test_bytecode_cache() -> bool:
+	if OS.has_feature("editor"):
+		var cache_path = "res://.godot/lua_gdextension/bytecode/%s.luac" % test_class.resource_path.md5_text()
+		assert(FileAccess.file_exists(cache_path), "Loading a script should write its bytecode to the cache")
+	var cached_script = ResourceLoader.load(test_class.resource_path, "", ResourceLoader.CACHE_MODE_IGNORE)
+	assert(cached_script.new(1).init_values == [1], "Scripts loaded from bytecode should behave like the ones loaded from source")
+	return true
+
+
+func test_threaded_load() -> bool:
+	var error = ResourceLoader.load_threaded_request(test_class.resource_path, "", true, ResourceLoader.CACHE_MODE_IGNORE)
+	assert(error == OK)
+	var threaded_script = ResourceLoader.load_threaded_get(test_class.resource_path)
+	assert(threaded_script is LuaScript)
+	assert(threaded_script.new(1).init_values == [1], "Scripts compiled in other threads should behave like the ones compiled in the main thread")
+	return true
+
+
+func test_threaded_load_evaluates_in_loading_thread() -> bool:
+	var path = "res://gdscript_tests/resource_files/threaded_resource.tres"
+	var error = ResourceLoader.load_threaded_request(path, "", true, ResourceLoader.CACHE_MODE_IGNORE_DEEP)
+	assert(error == OK)
+	var resource = ResourceLoader.load_threaded_get(path)
+	assert(resource.value == 42, "Resources deserialized in other threads should keep their exported property values")
+	assert(resource.init_called, "Resources deserialized in other threads should run their script's _init")
+	return true
+
+
+func _get_lua_script_language() -> LuaScriptLanguage:
+	for i in Engine.get_script_language_count():
+		var language = Engine.get_script_language(i)
+		if language is LuaScriptLanguage:
+			return language
+	return null
@@ -9,3 +9,41 @@ func test_rpc_call() -> bool:
 	obj.rpc("rpc_method")
 	assert(obj.rpc_called)
 	return true
+
+
+func test_self_is_table() -> bool:
+	var obj = test_class_node.new()
+	assert(obj.self_is_table(), "Non-RefCounted objects should be passed to Lua methods as tables")
+	obj.free()
+	return true
+
+
+func test_self_table_variables() -> bool:
+	var obj = test_class_node.new()
+	assert(obj.health == 10)
+	obj.damage(3)
+	assert(obj.health == 7)
+	obj.health = 1
+	assert(obj.get_health_from_lua() == 1)
+	obj.name = "TestName"
+	assert(obj.get_name_from_lua() == "TestName")
+	obj.free()
+	return true
+
+
+func test_shared_property_defaults_from_lua() -> bool:
+	var obj = test_class_node.new()
+	assert(obj.get_health_from_lua() == 10)
+	assert(obj.rawget("health") == null, "Defaults read from Lua should not be stored per instance, just like the ones read from Godot")
+	obj.free()
+	return true
+
+
+func test_self_table_setter() -> bool:
+	var obj = test_class_node.new()
+	obj.set_clamped_from_lua(5)
+	assert(obj.clamped == 3)
+	obj.set_clamped_from_lua(2)
+	assert(obj.clamped == 2)
+	obj.free()
+	return true
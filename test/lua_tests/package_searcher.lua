@@ -1,2 +1,17 @@
 assert(package.searchpath("lua_tests.package_searcher", "res://?.lua"))
 assert(not package.searchpath("module.that.doesnt.exist", "res://?.lua"))
+
+-- cached results should match the uncached ones
+assert(package.searchpath("lua_tests.package_searcher", "res://?.lua") == "res://lua_tests/package_searcher.lua")
+assert(not package.searchpath("module.that.doesnt.exist", "res://?.lua"))
+local _, err = package.searchpath("module.that.doesnt.exist", "res://?.lua")
+assert(err:find("res://module/that/doesnt/exist.lua", 1, true))
+
+-- modules created at runtime in writable locations must be found after a failed lookup
+local user_module = "user://package_searcher_user_module.lua"
+assert(not package.searchpath("package_searcher_user_module", "res://?.lua;user://?.lua"))
+local file = FileAccess:open(user_module, FileAccess.WRITE)
+file:store_string("return true")
+file:close()
+assert(package.searchpath("package_searcher_user_module", "res://?.lua;user://?.lua") == user_module)
+DirAccess:remove_absolute(user_module)
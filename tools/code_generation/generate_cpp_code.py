@@ -24,36 +24,104 @@ def _to_variant_type(s: str) -> str:
     return "Variant::" + re.sub("([a-z])([A-Z])|([0-9])(Array)", r"\1\3_\2\4", s).upper()
 
 
-def generate_utility_functions(utility_functions):
+def perfect_hash(key: str, seed: int) -> int:
+    """Must match `perfect_hash` in src/utils/perfect_hash.hpp"""
+    mask = 0xFFFFFFFF
+    h = (2166136261 ^ seed) & mask
+    for b in key.encode("utf-8"):
+        h ^= b
+        h = (h * 16777619) & mask
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & mask
+    h ^= h >> 13
+    h = (h * 0xC2B2AE35) & mask
+    h ^= h >> 16
+    return h
+
+
+def build_perfect_hash(keys):
+    """
+    Hash and displace: keys are distributed in buckets, then each bucket, largest first,
+    searches for a seed that puts all its keys in free slots.
+    Returns the list of keys in their slots and the list of bucket seeds.
+    """
+    bucket_count = len(keys) // 4 + 1
+    buckets = [[] for _ in range(bucket_count)]
+    for key in keys:
+        buckets[perfect_hash(key, 0) % bucket_count].append(key)
+
+    slots = [None] * len(keys)
+    seeds = [0] * bucket_count
+    for bucket_index in sorted(range(bucket_count), key=lambda i: -len(buckets[i])):
+        bucket = buckets[bucket_index]
+        if not bucket:
+            continue
+        seed = 1
+        while True:
+            positions = [perfect_hash(key, seed) % len(keys) for key in bucket]
+            if len(set(positions)) == len(positions) and all(slots[p] is None for p in positions):
+                break
+            seed += 1
+        for key, position in zip(bucket, positions):
+            slots[position] = key
+        seeds[bucket_index] = seed
+    return slots, seeds
+
+
+def generate_perfect_hash_table(header, value_type, name, values):
+    """`values` maps keys to their C++ value expression"""
+    slots, seeds = build_perfect_hash(list(values.keys()))
     lines = [
-        "// This file was automatically generated by generate_cpp_code.py\n#undef register_utility_functions\n#define register_utility_functions(state)",
+        "// This file was automatically generated by generate_cpp_code.py",
+        header,
+        f"static const luagdextension::PerfectHashEntry<{value_type}> {name}_entries[] = {{",
     ]
+    for key in slots:
+        lines.append(f'\t{{ "{key}", {values[key]} }},')
+    lines.append("};")
+    lines.append(f"static const uint32_t {name}_seeds[] = {{ {', '.join(str(seed) for seed in seeds)} }};")
+    return "\n".join(lines) + "\n"
+
+
+def generate_utility_functions(utility_functions):
+    values = {}
     for f in utility_functions:
         name = f["name"]
         funcname = UTILITY_FUNCTION_MAP.get(name, name)
         if funcname is None:
             continue
         if f.get("is_vararg", False):
-            lines.append(f'\tstate.set("{name}", &_call_variadic_utility_function<{f.get("return_type", "void")}, "{name}", {f.get("hash")}>);')
+            value = f'&_call_variadic_utility_function<{f.get("return_type", "void")}, "{name}", {f.get("hash")}>'
         elif (
             f.get("return_type") not in PRIMITIVE_VARIANTS
             or any(arg["type"] not in PRIMITIVE_VARIANTS for arg in f.get("arguments", []))
         ):
-            lines.append(f'\tstate.set("{name}", wrap_function(state, &UtilityFunctions::{funcname}));')
+            value = f"wrap_function(state, &UtilityFunctions::{funcname})"
         else:
-            lines.append(f'\tstate.set("{name}", &UtilityFunctions::{funcname});')
-    return " \\\n".join(lines) + "\n"
+            value = f"&UtilityFunctions::{funcname}"
+        values[name] = f'+[](sol::state_view& state) {{ state.set("{name}", {value}); }}'
+    return generate_perfect_hash_table(
+        '#include "../utils/perfect_hash.hpp"\n\ntypedef void (*UtilityFunctionRegistrar)(sol::state_view& state);',
+        "UtilityFunctionRegistrar",
+        "utility_function",
+        values,
+    )
 
 
 def generate_enums(global_enums):
-    lines = [
-        "// This file was automatically generated by generate_cpp_code.py\n#undef register_global_enums\n#define register_global_enums(state)",
-    ]
+    values = {}
     for enum in global_enums:
-        lines.append(f"\t/* {enum['name']} */")
         for value in enum["values"]:
-            lines.append(f'\tstate.set("{value["name"]}", {value["value"]});')
-    return " \\\n".join(lines) + "\n"
+            values[value["name"]] = str(value["value"])
+    return generate_perfect_hash_table('#include "../utils/perfect_hash.hpp"', "int64_t", "global_enum", values)
+
+
+def generate_variant_types(builtin_classes):
+    values = {}
+    for cls in builtin_classes:
+        if cls["name"] != "Nil":
+            values[cls["name"]] = "godot::" + _to_variant_type(cls["name"])
+    return generate_perfect_hash_table('#include "../utils/perfect_hash.hpp"', "godot::Variant::Type", "variant_type", values)
 
 
 def generate_package_searcher():
@@ -156,6 +224,10 @@ def main():
         code = generate_variant_type_constants(api["builtin_classes"])
         f.write(code)
 
+    with open(os.path.join(DEST_DIR, "variant_types.hpp"), "w") as f:
+        code = generate_variant_types(api["builtin_classes"])
+        f.write(code)
+
 
 if __name__ == "__main__":
     main()
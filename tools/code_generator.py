@@ -15,10 +15,12 @@ def generate(env):
             "src/generated/package_searcher.h",
             "src/generated/lua_script_globals.h",
             "src/generated/variant_type_constants.hpp",
+            "src/generated/variant_types.hpp",
         ],
         [
             "tools/code_generation/generate_cpp_code.py",
             "src/luaopen/package_searcher.lua",
+            "src/utils/perfect_hash.hpp",
             "src/script-language/globals.lua",
             "lib/godot-cpp/gdextension/extension_api.json",
             "lib/godot-cpp/gen/include/godot_cpp/variant/utility_functions.hpp",